@@ -0,0 +1,241 @@
+#include "pch.h"
+#include "AllocationGuard.h"
+
+#include <combaseapi.h>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    thread_local int armedDepth = 0;
+    thread_local const void* lastPointer = nullptr; // Last allocation recorded on this thread
+    thread_local size_t lastSite = AllocationGuard::MaxSites;
+
+    std::atomic<uint64_t> allocationCount{0};
+    std::array<std::atomic<uint64_t>, AllocationGuard::MaxSites> siteKeys{};
+    std::array<AllocationGuard::Site, AllocationGuard::MaxSites> sites{};
+
+    // Record an allocation, must not allocate itself
+    void RecordAllocation(const wchar_t* allocator, const void* pointer)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        lastPointer = pointer;
+        lastSite = AllocationGuard::MaxSites;
+
+        std::array<void*, AllocationGuard::SiteDepth> frames{};
+        const auto captured = CaptureStackBackTrace(2, static_cast<DWORD>(frames.size()), frames.data(), nullptr);
+
+        uint64_t key = 1469598103934665603ull; // FNV-1a over the frames
+        for (USHORT i = 0; i < captured; i++)
+            key = (key ^ reinterpret_cast<uint64_t>(frames[i])) * 1099511628211ull;
+
+        for (size_t i = 0; i < siteKeys.size(); i++)
+        {
+            uint64_t current = siteKeys[i].load(std::memory_order_acquire);
+            if (current == 0 && siteKeys[i].compare_exchange_strong(current, key, std::memory_order_acq_rel))
+            {
+                sites[i].allocator = allocator; // Claimed a new slot
+                sites[i].frames = frames;
+                current = key;
+            }
+
+            if (current != key) continue;
+            std::atomic_ref(sites[i].count).fetch_add(1, std::memory_order_relaxed);
+            lastSite = i;
+            return;
+        }
+    }
+
+    // Run <allocate> and record it if the thread is armed
+    // Disarms while inside, so a CRT built on the hooked imports doesn't count twice
+    template <typename F>
+    void* Guarded(const wchar_t* allocator, F&& allocate)
+    {
+        if (armedDepth <= 0) return allocate();
+
+        armedDepth = -armedDepth;
+        void* pointer = allocate();
+        if (pointer) RecordAllocation(allocator, pointer);
+        armedDepth = -armedDepth;
+
+        return pointer;
+    }
+
+    void* GuardedAllocate(const size_t size)
+    {
+        return Guarded(L"operator new", [=] { return std::malloc(size ? size : 1); });
+    }
+
+    decltype(&HeapAlloc) originalHeapAlloc = nullptr;
+    decltype(&HeapReAlloc) originalHeapReAlloc = nullptr;
+    decltype(&CoTaskMemAlloc) originalCoTaskMemAlloc = nullptr;
+    decltype(&CoTaskMemRealloc) originalCoTaskMemRealloc = nullptr;
+
+    LPVOID WINAPI HookedHeapAlloc(const HANDLE heap, const DWORD flags, const SIZE_T size)
+    {
+        return Guarded(L"HeapAlloc", [=] { return originalHeapAlloc(heap, flags, size); });
+    }
+
+    LPVOID WINAPI HookedHeapReAlloc(const HANDLE heap, const DWORD flags, const LPVOID memory, const SIZE_T size)
+    {
+        return Guarded(L"HeapReAlloc", [=] { return originalHeapReAlloc(heap, flags, memory, size); });
+    }
+
+    LPVOID WINAPI HookedCoTaskMemAlloc(const SIZE_T size)
+    {
+        return Guarded(L"CoTaskMemAlloc", [=] { return originalCoTaskMemAlloc(size); });
+    }
+
+    LPVOID WINAPI HookedCoTaskMemRealloc(const LPVOID memory, const SIZE_T size)
+    {
+        return Guarded(L"CoTaskMemRealloc", [=] { return originalCoTaskMemRealloc(memory, size); });
+    }
+
+    // Point every import of <name> in <module> at <hook>, returns the original
+    // Imports are matched by name, whichever DLL (or API set) they're bound to
+    template <typename F>
+    bool PatchImport(const HMODULE module, const char* name, F hook, F& original)
+    {
+        auto* base = reinterpret_cast<BYTE*>(module);
+        const auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        const auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+
+        const auto& directory = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+        if (directory.VirtualAddress == 0) return false;
+
+        bool patched = false;
+        for (auto* descriptor = reinterpret_cast<const IMAGE_IMPORT_DESCRIPTOR*>(base + directory.VirtualAddress);
+             descriptor->Name != 0; descriptor++)
+        {
+            if (descriptor->OriginalFirstThunk == 0) continue; // No names to match against
+
+            const auto* names = reinterpret_cast<const IMAGE_THUNK_DATA*>(base + descriptor->OriginalFirstThunk);
+            auto* slots = reinterpret_cast<IMAGE_THUNK_DATA*>(base + descriptor->FirstThunk);
+
+            for (; names->u1.AddressOfData != 0; names++, slots++)
+            {
+                if (IMAGE_SNAP_BY_ORDINAL(names->u1.Ordinal)) continue;
+
+                const auto* import = reinterpret_cast<const IMAGE_IMPORT_BY_NAME*>(base + names->u1.AddressOfData);
+                if (std::strcmp(reinterpret_cast<const char*>(import->Name), name) != 0) continue;
+
+                DWORD protection = 0;
+                if (!VirtualProtect(&slots->u1.Function, sizeof(slots->u1.Function), PAGE_READWRITE, &protection))
+                    continue;
+
+                if (!original) original = reinterpret_cast<F>(slots->u1.Function);
+                slots->u1.Function = reinterpret_cast<ULONG_PTR>(hook);
+
+                VirtualProtect(&slots->u1.Function, sizeof(slots->u1.Function), protection, &protection);
+                patched = true;
+            }
+        }
+
+        return patched;
+    }
+}
+
+namespace AllocationGuard
+{
+    Scope::Scope(const bool arm) : armed(arm)
+    {
+        if (armed) armedDepth++;
+    }
+
+    Scope::~Scope()
+    {
+        if (armed) armedDepth--;
+    }
+
+    bool HookImports()
+    {
+        const auto module = GetModuleHandle(nullptr);
+
+        // Nothing may need to reallocate at all, so those imports are optional
+        PatchImport(module, "HeapReAlloc", &HookedHeapReAlloc, originalHeapReAlloc);
+        PatchImport(module, "CoTaskMemRealloc", &HookedCoTaskMemRealloc, originalCoTaskMemRealloc);
+
+        const bool heap = PatchImport(module, "HeapAlloc", &HookedHeapAlloc, originalHeapAlloc);
+        const bool task = PatchImport(module, "CoTaskMemAlloc", &HookedCoTaskMemAlloc, originalCoTaskMemAlloc);
+        return heap && task;
+    }
+
+    uint64_t Count()
+    {
+        return allocationCount.load(std::memory_order_relaxed);
+    }
+
+    bool Excuse(const void* pointer)
+    {
+        if (pointer == nullptr || pointer != lastPointer) return false;
+
+        allocationCount.fetch_sub(1, std::memory_order_relaxed);
+        if (lastSite < MaxSites) std::atomic_ref(sites[lastSite].count).fetch_sub(1, std::memory_order_relaxed);
+
+        lastPointer = nullptr;
+        lastSite = MaxSites;
+        return true;
+    }
+
+    size_t Sites(Site* out, const size_t max)
+    {
+        size_t written = 0;
+        for (size_t i = 0; i < siteKeys.size() && written < max; i++)
+        {
+            if (siteKeys[i].load(std::memory_order_acquire) == 0) continue;
+
+            out[written] = sites[i];
+            out[written].count = std::atomic_ref(sites[i].count).load(std::memory_order_relaxed);
+            if (out[written].count > 0) written++; // Leave out sites that were excused entirely
+        }
+
+        return written;
+    }
+
+    std::wstring DescribeAddress(const void* address)
+    {
+        HMODULE module = nullptr;
+        if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                               GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                               static_cast<LPCWSTR>(address), &module))
+            return std::format(L"{}", address);
+
+        wchar_t path[MAX_PATH] = {};
+        GetModuleFileName(module, path, MAX_PATH);
+
+        const std::wstring_view name(path);
+        return std::format(L"{}+0x{:x}", name.substr(name.find_last_of(L'\\') + 1),
+                           reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(module));
+    }
+}
+
+// Global allocator hook, counts allocations made on armed threads
+void* operator new(const size_t size)
+{
+    if (void* pointer = GuardedAllocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size)
+{
+    if (void* pointer = GuardedAllocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept
+{
+    return GuardedAllocate(size);
+}
+
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept
+{
+    return GuardedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
@@ -0,0 +1,50 @@
+#pragma once
+#include <pch.h>
+
+// Counts heap allocations made on guarded threads, along with their call sites
+// AllocationGuard.cpp replaces the global operator new/delete of whatever links it,
+// HookImports() adds the heap and COM task allocators C++/WinRT goes through
+namespace AllocationGuard
+{
+    constexpr size_t MaxSites = 32; // Distinct call sites we'll keep track of
+    constexpr size_t SiteDepth = 8; // Stack frames recorded per call site
+
+    struct Site
+    {
+        const wchar_t* allocator = nullptr; // Which allocator the site went through
+        std::array<void*, SiteDepth> frames{};
+        uint64_t count = 0;
+    };
+
+    // Arms the guard for the calling thread while alive (if <arm> is set)
+    class Scope
+    {
+    public:
+        explicit Scope(bool arm = true);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool armed;
+    };
+
+    // Route the calling executable's HeapAlloc/HeapReAlloc and CoTaskMemAlloc/CoTaskMemRealloc
+    // imports through the guard too, that's where hstrings and com_arrays get their memory
+    // Returns false unless both allocation imports were found
+    bool HookImports();
+
+    // Allocations seen while armed, in total
+    uint64_t Count();
+
+    // Take back the last allocation made on the calling thread, if it returned <pointer>
+    // For buffers an ABI contract requires, like the array a projected getter hands out
+    bool Excuse(const void* pointer);
+
+    // Copy out up to <max> recorded call sites, returns how many were written
+    size_t Sites(Site* out, size_t max);
+
+    // Format a code address as module+offset, for lookup against the PDB
+    std::wstring DescribeAddress(const void* address);
+}
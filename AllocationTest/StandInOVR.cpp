@@ -0,0 +1,267 @@
+#include "pch.h"
+
+#include <d3d11.h>
+#include <dxgi.h>
+#include <OVR_CAPI_D3D.h>
+
+// A stand-in for the LibOVR entry points the handler uses, so it can run
+// without a headset or the Oculus runtime: a mounted HMD, two Touch controllers
+// and one tracked object, all moving along fixed paths so no frame ever rests
+
+struct ovrHmdStruct
+{
+    std::atomic<uint32_t> compositorFrame{0};
+};
+
+struct ovrTextureSwapChainData
+{
+    std::array<ID3D11Texture2D*, 3> textures{};
+    int current = 0;
+};
+
+namespace
+{
+    const auto epoch = std::chrono::steady_clock::now();
+
+    // Where device <index> is at <time>, each on a circle of its own
+    ovrPoseStatef StandInPose(const int index, const double time)
+    {
+        const double phase = time * 2.0 + index * 1.7;
+        const double yaw = std::sin(phase) * 0.5;
+
+        ovrPoseStatef pose{};
+        pose.ThePose.Orientation = {0.f, static_cast<float>(std::sin(yaw / 2)), 0.f, static_cast<float>(std::cos(yaw / 2))};
+        pose.ThePose.Position = {
+            static_cast<float>(0.3 * (index - 1) + 0.1 * std::cos(phase)),
+            static_cast<float>(1.2 + 0.05 * std::sin(phase * 2)),
+            static_cast<float>(-0.3 + 0.1 * std::sin(phase))
+        };
+        pose.LinearVelocity = {
+            static_cast<float>(-0.2 * std::sin(phase)),
+            static_cast<float>(0.2 * std::cos(phase * 2)),
+            static_cast<float>(0.2 * std::cos(phase))
+        };
+        pose.AngularVelocity = {0.f, static_cast<float>(std::cos(phase)), 0.f};
+        pose.TimeInSeconds = time;
+        return pose;
+    }
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_Initialize(const ovrInitParams*)
+{
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_Shutdown()
+{
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_Create(ovrSession* pSession, ovrGraphicsLuid* pLuid)
+{
+    // Whatever adapter comes first, WARP on machines without a GPU
+    *pLuid = {};
+    IDXGIFactory1* factory = nullptr;
+    if (SUCCEEDED(CreateDXGIFactory1(__uuidof(IDXGIFactory1), reinterpret_cast<void**>(&factory))))
+    {
+        IDXGIAdapter1* adapter = nullptr;
+        if (SUCCEEDED(factory->EnumAdapters1(0, &adapter)))
+        {
+            DXGI_ADAPTER_DESC1 desc{};
+            adapter->GetDesc1(&desc);
+            std::memcpy(pLuid, &desc.AdapterLuid, sizeof(LUID));
+            adapter->Release();
+        }
+
+        factory->Release();
+    }
+
+    *pSession = new ovrHmdStruct;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_Destroy(ovrSession session)
+{
+    delete session;
+}
+
+OVR_PUBLIC_FUNCTION(ovrHmdDesc) ovr_GetHmdDesc(ovrSession)
+{
+    ovrHmdDesc desc{};
+    desc.Type = ovrHmd_CV1;
+    desc.Resolution = {2160, 1200};
+    desc.DisplayRefreshRate = 90.f;
+    for (auto& fov : desc.DefaultEyeFov) fov = {1.f, 1.f, 1.f, 1.f};
+    for (auto& fov : desc.MaxEyeFov) fov = {1.f, 1.f, 1.f, 1.f};
+    return desc;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_SetTrackingOriginType(ovrSession, ovrTrackingOrigin)
+{
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(unsigned int) ovr_GetConnectedControllerTypes(ovrSession)
+{
+    return ovrControllerType_LTouch | ovrControllerType_RTouch | ovrControllerType_Object0;
+}
+
+OVR_PUBLIC_FUNCTION(ovrSizei) ovr_GetFovTextureSize(ovrSession, ovrEyeType, ovrFovPort, const float pixelsPerDisplayPixel)
+{
+    // Small, we never look at what's rendered
+    const int side = static_cast<int>(256 * pixelsPerDisplayPixel);
+    return {side, side};
+}
+
+OVR_PUBLIC_FUNCTION(ovrEyeRenderDesc) ovr_GetRenderDesc(ovrSession, const ovrEyeType eyeType, const ovrFovPort fov)
+{
+    ovrEyeRenderDesc desc{};
+    desc.Eye = eyeType;
+    desc.Fov = fov;
+    desc.HmdToEyePose.Orientation.w = 1.f;
+    desc.HmdToEyePose.Position.x = eyeType == ovrEye_Left ? -0.032f : 0.032f;
+    return desc;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_CreateTextureSwapChainDX(ovrSession, IUnknown* d3dPtr,
+                                                            const ovrTextureSwapChainDesc* desc,
+                                                            ovrTextureSwapChain* out_TextureSwapChain)
+{
+    ID3D11Device* device = nullptr;
+    if (FAILED(d3dPtr->QueryInterface(IID_PPV_ARGS(&device)))) return ovrError_InvalidParameter;
+
+    // Typeless, so the handler can view it as UNORM like the real runtime allows
+    const D3D11_TEXTURE2D_DESC textureDesc = {
+        static_cast<UINT>(desc->Width), static_cast<UINT>(desc->Height), 1, 1, DXGI_FORMAT_R8G8B8A8_TYPELESS, {1, 0},
+        D3D11_USAGE_DEFAULT, D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE, 0, 0
+    };
+
+    auto* chain = new ovrTextureSwapChainData;
+    for (auto& texture : chain->textures)
+        device->CreateTexture2D(&textureDesc, nullptr, &texture);
+
+    device->Release();
+    *out_TextureSwapChain = chain;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetTextureSwapChainLength(ovrSession, ovrTextureSwapChain chain, int* out_Length)
+{
+    *out_Length = static_cast<int>(chain->textures.size());
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetTextureSwapChainBufferDX(ovrSession, ovrTextureSwapChain chain, const int index,
+                                                               const IID iid, void** out_Buffer)
+{
+    const auto texture = chain->textures[index];
+    return texture && SUCCEEDED(texture->QueryInterface(iid, out_Buffer)) ? ovrSuccess : ovrError_InvalidParameter;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetTextureSwapChainCurrentIndex(ovrSession, ovrTextureSwapChain chain,
+                                                                   int* out_Index)
+{
+    *out_Index = chain->current;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_CommitTextureSwapChain(ovrSession, ovrTextureSwapChain chain)
+{
+    chain->current = (chain->current + 1) % static_cast<int>(chain->textures.size());
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_DestroyTextureSwapChain(ovrSession, ovrTextureSwapChain chain)
+{
+    for (const auto texture : chain->textures)
+        if (texture) texture->Release();
+    delete chain;
+}
+
+OVR_PUBLIC_FUNCTION(double) ovr_GetTimeInSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetEyePoses(ovrSession, long long, ovrBool, const ovrPosef hmdToEyePose[2],
+                                               ovrPosef outEyePoses[2], double* outSensorSampleTime)
+{
+    const double time = ovr_GetTimeInSeconds();
+    for (int i = 0; i < ovrEye_Count; i++)
+    {
+        outEyePoses[i] = StandInPose(1, time).ThePose;
+        outEyePoses[i].Position.x += hmdToEyePose[i].Position.x;
+    }
+
+    if (outSensorSampleTime) *outSensorSampleTime = time;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_SubmitFrame(ovrSession session, long long, const ovrViewScaleDesc*,
+                                               ovrLayerHeader const* const*, unsigned int)
+{
+    session->compositorFrame.fetch_add(1, std::memory_order_relaxed);
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetSessionStatus(ovrSession, ovrSessionStatus* sessionStatus)
+{
+    *sessionStatus = {};
+    sessionStatus->IsVisible = ovrTrue;
+    sessionStatus->HmdPresent = ovrTrue;
+    sessionStatus->HmdMounted = ovrTrue;
+    sessionStatus->HasInputFocus = ovrTrue;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrTrackingState) ovr_GetTrackingState(ovrSession, const double absTime, ovrBool)
+{
+    constexpr unsigned int tracked_flags = ovrStatus_OrientationTracked | ovrStatus_PositionTracked;
+
+    ovrTrackingState state{};
+    state.HeadPose = StandInPose(1, absTime);
+    state.HeadPose.ThePose.Position.y += 0.5f; // Above the hands
+    state.StatusFlags = tracked_flags;
+
+    for (int i = 0; i <= 1; i++)
+    {
+        state.HandPoses[i] = StandInPose(i * 2, absTime); // Left and right of the head
+        state.HandStatusFlags[i] = tracked_flags;
+    }
+
+    state.CalibratedOrigin.Orientation.w = 1.f;
+    return state;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetDevicePoses(ovrSession, ovrTrackedDeviceType* deviceTypes, const int deviceCount,
+                                                  const double absTime, ovrPoseStatef* outDevicePoses)
+{
+    for (int i = 0; i < deviceCount; i++)
+        outDevicePoses[i] = StandInPose(3 + static_cast<int>(deviceTypes[i]), absTime);
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetPerfStats(ovrSession session, ovrPerfStats* outStats)
+{
+    const auto frame = static_cast<int>(session->compositorFrame.load(std::memory_order_relaxed));
+
+    *outStats = {};
+    outStats->FrameStatsCount = 1;
+    outStats->AdaptiveGpuPerformanceScale = 1.f;
+    outStats->FrameStats[0].HmdVsyncIndex = frame;
+    outStats->FrameStats[0].AppFrameIndex = frame;
+    outStats->FrameStats[0].CompositorFrameIndex = frame;
+    outStats->FrameStats[0].AppMotionToPhotonLatency = 0.02f;
+    outStats->FrameStats[0].AppQueueAheadTime = 0.005f;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetBoundaryGeometry(ovrSession, ovrBoundaryType, ovrVector3f* outFloorPoints,
+                                                       int* outFloorPointsCount)
+{
+    // A fixed 2x2 m play area
+    constexpr std::array<ovrVector3f, 4> corners{{{-1.f, 0.f, -1.f}, {1.f, 0.f, -1.f}, {1.f, 0.f, 1.f}, {-1.f, 0.f, 1.f}}};
+
+    if (outFloorPoints) std::copy(corners.begin(), corners.end(), outFloorPoints);
+    if (outFloorPointsCount) *outFloorPointsCount = static_cast<int>(corners.size());
+    return ovrSuccess;
+}
@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "ThreadLauncherTest.h"
+#include "ThreadLauncher.h"
+
+#include <bit>
+#include <iostream>
+
+namespace
+{
+    constexpr int Wakeups = 20;
+    constexpr auto Period = std::chrono::milliseconds(2);
+
+    bool Check(const bool condition, const wchar_t* what)
+    {
+        if (!condition) std::wcout << L"ThreadLauncher: " << what << L'\n';
+        return condition;
+    }
+}
+
+bool TestThreadLauncher()
+{
+    // The lowest core we're allowed on, and nothing else
+    DWORD_PTR process = 0, system = 0;
+    if (!Check(GetProcessAffinityMask(GetCurrentProcess(), &process, &system) && process,
+               L"couldn't read the process affinity mask!"))
+        return false;
+
+    const auto core = static_cast<DWORD>(std::countr_zero(static_cast<uint64_t>(process)));
+    const auto previous = ThreadLauncher::Current(ThreadLauncher::Role::Worker);
+    ThreadLauncher::Configure(ThreadLauncher::Role::Worker, {
+                                  .priority = ThreadLauncher::Priority::AboveNormal,
+                                  .affinity = 1ull << core
+                              });
+
+    bool stayed = true;
+    ThreadLauncher::Launch("Launcher test", ThreadLauncher::Role::Worker, [&]
+    {
+        auto next = ThreadLauncher::clock::now();
+        for (int i = 0; i < Wakeups; i++)
+        {
+            next += Period;
+            ThreadLauncher::SleepUntil(next);
+            stayed &= GetCurrentProcessorNumber() == core;
+        }
+    }).join();
+
+    ThreadLauncher::Configure(ThreadLauncher::Role::Worker, previous);
+
+    std::array<ThreadLauncher::WakeStats, ThreadLauncher::MaxThreads> stats{};
+    const auto count = ThreadLauncher::Stats(stats.data(), stats.size());
+    const auto found = std::find_if(stats.begin(), stats.begin() + count, [](const auto& entry)
+    {
+        return entry.name && std::strcmp(entry.name, "Launcher test") == 0;
+    });
+
+    if (!Check(found != stats.begin() + count, L"the thread never showed up in the stats!"))
+        return false;
+
+    std::wcout << std::format(L"ThreadLauncher: {} wake-ups on core {}, {:.1f} us late on average, {:.1f} us at worst\n",
+                              found->wakeups, core, found->meanUs, found->maxUs);
+
+    bool passed = true;
+    passed &= Check(found->applied, L"the schedule wasn't applied!");
+    passed &= Check(stayed, L"the thread ran outside of its affinity mask!");
+    passed &= Check(!found->running, L"the thread is still marked as running!");
+    passed &= Check(found->wakeups == Wakeups, L"wake-ups weren't all recorded!");
+    passed &= Check(found->meanUs > 0.0 && found->maxUs >= found->meanUs, L"no wake-up latency was recorded!");
+    return passed;
+}
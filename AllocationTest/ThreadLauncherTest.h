@@ -0,0 +1,7 @@
+#pragma once
+#include <pch.h>
+
+// Launches a worker pinned to one core with a deadline sleep loop and checks
+// the schedule went through, it stayed on that core and its wake-ups were
+// recorded, returns false (and says why) if anything's off
+bool TestThreadLauncher();
@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "AllocationGuard.h"
+#include "ThreadLauncherTest.h"
+#include "TrackingHandler.h"
+
+#include <DbgHelp.h>
+#include <cstdlib>
+#include <iostream>
+
+// Checks native thread scheduling first, then drives the handler against the
+// stand-in runtime the way the host does, Initialize() and then Update() +
+// TrackedJoints() once per frame, and fails if a steady-state frame allocates
+// anything on the calling thread
+
+namespace
+{
+    constexpr unsigned int WarmupFrames = 1000; // First-frame setup, config and boundary logs
+    constexpr unsigned int DefaultFrames = 10000; // Per pass
+
+    // Module+offset, plus the symbol and source line if there's a PDB around
+    std::wstring Symbolize(const HANDLE process, const void* address)
+    {
+        auto text = AllocationGuard::DescribeAddress(address);
+
+        std::array<BYTE, sizeof(SYMBOL_INFOW) + MAX_SYM_NAME * sizeof(wchar_t)> buffer{};
+        auto* symbol = reinterpret_cast<SYMBOL_INFOW*>(buffer.data());
+        symbol->SizeOfStruct = sizeof(SYMBOL_INFOW);
+        symbol->MaxNameLen = MAX_SYM_NAME;
+
+        DWORD64 displacement = 0;
+        if (SymFromAddrW(process, reinterpret_cast<DWORD64>(address), &displacement, symbol))
+            text += std::format(L" {}", symbol->Name);
+
+        IMAGEHLP_LINEW64 line{.SizeOfStruct = sizeof(IMAGEHLP_LINEW64)};
+        DWORD column = 0;
+        if (SymGetLineFromAddrW64(process, reinterpret_cast<DWORD64>(address), &column, &line))
+            text += std::format(L" ({}:{})", line.FileName, line.LineNumber);
+
+        return text;
+    }
+
+    void ReportSites()
+    {
+        const auto process = GetCurrentProcess();
+        SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+        SymInitializeW(process, nullptr, TRUE);
+
+        std::array<AllocationGuard::Site, AllocationGuard::MaxSites> sites{};
+        const auto count = AllocationGuard::Sites(sites.data(), sites.size());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            std::wcout << std::format(L"{}x {}:\n", sites[i].count, sites[i].allocator);
+            for (const auto address : sites[i].frames)
+                if (address) std::wcout << L"    " << Symbolize(process, address) << L'\n';
+        }
+
+        if (count == AllocationGuard::MaxSites)
+            std::wcout << L"(call site table full, there may be more)\n";
+
+        SymCleanup(process);
+    }
+
+    // Warm up, then run <frames> guarded frames, returns how many allocations they made
+    uint64_t Run(const winrt::DeviceHandler::TrackingHandler& handler, const unsigned int frames)
+    {
+        for (unsigned int i = 0; i < WarmupFrames; i++)
+        {
+            handler.Update();
+            (void)handler.TrackedJoints();
+        }
+
+        const auto before = AllocationGuard::Count();
+        AllocationGuard::Scope guard;
+
+        for (unsigned int i = 0; i < frames; i++)
+        {
+            handler.Update();
+
+            // Returning an array across the ABI means the callee fills a CoTaskMemAlloc'd
+            // buffer for the caller to free, that single allocation is the contract
+            // Anything else made on the way, like a copied hstring, still counts
+            const auto joints = handler.TrackedJoints();
+            AllocationGuard::Excuse(joints.data());
+        }
+
+        return AllocationGuard::Count() - before;
+    }
+}
+
+int wmain(const int argc, wchar_t* argv[])
+{
+    const unsigned int frames = argc > 1 ? std::wcstoul(argv[1], nullptr, 10) : DefaultFrames;
+    if (!TestThreadLauncher()) return 1;
+
+    // hstrings and com_arrays don't go through operator new, watch their allocators too
+    if (!AllocationGuard::HookImports())
+    {
+        std::wcout << L"Couldn't hook the heap and COM task allocator imports!\n";
+        return 2;
+    }
+
+    const auto handler = winrt::make<winrt::DeviceHandler::implementation::TrackingHandler>();
+    handler.LogEvent([](const auto&, const winrt::hstring& message)
+    {
+        std::wcout << message.c_str() << L'\n';
+    });
+
+    if (const auto status = handler.Initialize(); status != S_OK)
+    {
+        std::wcout << std::format(L"Initialize() failed with {:#x}!\n", static_cast<uint32_t>(status));
+        return 2;
+    }
+
+    // Default settings, then again with the high-rate sampler feeding the frames
+    const auto plain = Run(handler, frames);
+    std::wcout << std::format(L"{} frames: {} allocations\n", frames, plain);
+
+    handler.Oversampling(true);
+    const auto oversampled = Run(handler, frames);
+    std::wcout << std::format(L"{} oversampled frames: {} allocations\n", frames, oversampled);
+
+    handler.Shutdown();
+
+    if (plain + oversampled == 0) return 0;
+
+    ReportSites();
+    return 1;
+}
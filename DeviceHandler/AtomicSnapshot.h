@@ -0,0 +1,91 @@
+#pragma once
+#include <pch.h>
+
+// Sequence-locked snapshot of a small, trivially copyable value
+// Readers never block and never see a torn value, writers are serialized
+// The payload lives in atomic words so concurrent access stays well-defined
+template <typename T>
+class AtomicSnapshot
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshots must be trivially copyable");
+    static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    explicit AtomicSnapshot(const T& value = {})
+    {
+        Store(value);
+    }
+
+    // Publish a new value, bumps the version (callable from any thread)
+    void Store(const T& value)
+    {
+        Modify([&](T& current) { current = value; });
+    }
+
+    // Read-modify-write the value, serialized against other writers
+    template <typename F>
+    void Modify(F&& modify)
+    {
+        while (writing.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        // We're the only writer now, so the words can't change under us
+        std::array<uint64_t, WordCount> buffer{};
+        for (size_t i = 0; i < WordCount; i++)
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+
+        T value;
+        std::memcpy(&value, buffer.data(), sizeof(T));
+        modify(value);
+        std::memcpy(buffer.data(), &value, sizeof(T));
+
+        const auto sequence = sequenceNumber.load(std::memory_order_relaxed);
+        sequenceNumber.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WordCount; i++)
+            words[i].store(buffer[i], std::memory_order_relaxed);
+
+        sequenceNumber.store(sequence + 2, std::memory_order_release);
+        writing.clear(std::memory_order_release);
+    }
+
+    // Read a consistent copy, retries only if a write raced with us
+    [[nodiscard]] T Load(uint64_t* version = nullptr) const
+    {
+        std::array<uint64_t, WordCount> buffer{};
+        uint64_t sequence;
+
+        while (true)
+        {
+            sequence = sequenceNumber.load(std::memory_order_acquire);
+            if (sequence & 1)
+            {
+                std::this_thread::yield();
+                continue; // Somebody's writing right now
+            }
+
+            for (size_t i = 0; i < WordCount; i++)
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequenceNumber.load(std::memory_order_relaxed) == sequence) break;
+        }
+
+        T value;
+        std::memcpy(&value, buffer.data(), sizeof(T));
+        if (version) *version = sequence / 2;
+        return value;
+    }
+
+    // Incremented by one on every Store()
+    [[nodiscard]] uint64_t Version() const
+    {
+        return sequenceNumber.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    std::atomic<uint64_t> sequenceNumber{0};
+    std::atomic_flag writing;
+    std::array<std::atomic<uint64_t>, WordCount> words{};
+};
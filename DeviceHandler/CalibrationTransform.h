@@ -0,0 +1,68 @@
+#pragma once
+#include <pch.h>
+
+#include "Win32_DirectXAppUtil.h"
+
+// Rigid (+ uniform scale) transform taking poses out of the OVR
+// floor-level origin and into the host's calibrated space
+struct CalibrationTransform
+{
+    XMFLOAT4 rotation{0.f, 0.f, 0.f, 1.f};
+    XMFLOAT3 translation{0.f, 0.f, 0.f};
+    float scale = 1.f;
+
+    [[nodiscard]] bool IsIdentity() const
+    {
+        return rotation.x == 0.f && rotation.y == 0.f && rotation.z == 0.f &&
+            translation.x == 0.f && translation.y == 0.f && translation.z == 0.f && scale == 1.f;
+    }
+
+    // Transform all joints in place, in one pass
+    template <typename JointT>
+    void Apply(JointT* joints, const size_t count) const
+    {
+        if (IsIdentity()) return; // Nothing to do
+
+        const XMVECTOR q = XMLoadFloat4(&rotation);
+        const XMVECTOR t = XMLoadFloat3(&translation);
+        const XMVECTOR s = XMVectorReplicate(scale);
+
+        const auto point = [&](auto& v)
+        {
+            XMFLOAT3 value{v.X, v.Y, v.Z};
+            XMStoreFloat3(&value, XMVectorMultiplyAdd(
+                              XMVector3Rotate(XMLoadFloat3(&value), q), s, t));
+            v = {value.x, value.y, value.z};
+        };
+
+        const auto direction = [&](auto& v, const bool scaled)
+        {
+            XMFLOAT3 value{v.X, v.Y, v.Z};
+            XMVECTOR rotated = XMVector3Rotate(XMLoadFloat3(&value), q);
+            XMStoreFloat3(&value, scaled ? XMVectorMultiply(rotated, s) : rotated);
+            v = {value.x, value.y, value.z};
+        };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            auto& joint = joints[i];
+            point(joint.Position);
+            point(joint.BoundaryPoint);
+
+            // Linear quantities scale, angular ones only rotate
+            direction(joint.Velocity, true);
+            direction(joint.Acceleration, true);
+            direction(joint.AngularVelocity, false);
+            direction(joint.AngularAcceleration, false);
+
+            XMFLOAT4 orientation{
+                joint.Orientation.X, joint.Orientation.Y,
+                joint.Orientation.Z, joint.Orientation.W
+            };
+
+            XMStoreFloat4(&orientation, XMQuaternionMultiply(XMLoadFloat4(&orientation), q));
+            joint.Orientation = {orientation.x, orientation.y, orientation.z, orientation.w};
+            joint.BoundaryDistance *= scale;
+        }
+    }
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <pch.h>
+
+#include <bit>
+#include <OVR_CAPI.h>
+
+// Tells which joints moved enough since they were last exported, so the
+// handler and its consumers can leave the resting ones alone
+class ChangeDetector
+{
+public:
+    static constexpr size_t MaxJoints = 32; // One bit per joint
+
+    float restSpeed = 0.01f; // [m/s] Slower than this counts as at rest
+    float restAngularSpeed = 0.05f; // [rad/s] Slower than this counts as at rest
+
+    struct Stats
+    {
+        uint64_t updates = 0; // Frames we've compared
+        uint64_t jointsProcessed = 0; // Joints rebuilt and exported
+        uint64_t jointsSkipped = 0; // Joints left as they were
+        uint64_t consumerPolls = 0; // Consume() calls
+        uint64_t copiesSkipped = 0; // Polls that found nothing changed
+        uint64_t consumerJointsSkipped = 0; // Unchanged joints handed to consumers
+    };
+
+    // Thresholds, 0 or less makes every frame count as a change
+    void SetEpsilon(const float position, const float angle)
+    {
+        positionEpsilonSq = position > 0.f ? position * position : -1.f;
+        orientationDot = angle > 0.f ? std::cos(angle * 0.5f) : 2.f; // |dot| below this has turned
+    }
+
+    // Has <pose> moved past the thresholds since joint <index> was last accepted
+    // Coming to rest counts too, so the exported velocities don't stay behind
+    [[nodiscard]] bool Moved(const size_t index, const ovrPoseStatef& pose) const
+    {
+        if (!AtRest(reference[index]) && AtRest(pose)) return true;
+
+        const auto& last = reference[index].ThePose;
+        const auto& now = pose.ThePose;
+
+        const float dx = now.Position.x - last.Position.x;
+        const float dy = now.Position.y - last.Position.y;
+        const float dz = now.Position.z - last.Position.z;
+        if (dx * dx + dy * dy + dz * dz > positionEpsilonSq) return true;
+
+        const float dot = now.Orientation.x * last.Orientation.x + now.Orientation.y * last.Orientation.y +
+            now.Orientation.z * last.Orientation.z + now.Orientation.w * last.Orientation.w;
+        return std::abs(dot) < orientationDot;
+    }
+
+    // Remember <pose> as the one exported for joint <index>
+    void Accept(const size_t index, const ovrPoseStatef& pose)
+    {
+        reference[index] = pose;
+    }
+
+    // Make the next frame treat every joint as changed
+    void Invalidate()
+    {
+        invalidated = true;
+    }
+
+    // Take the pending invalidation, if any
+    bool TakeInvalidation()
+    {
+        return std::exchange(invalidated, false);
+    }
+
+    // Publish this frame's mask of <count> joints, producer side
+    void Publish(const uint32_t mask, const size_t count)
+    {
+        const auto changed = static_cast<uint64_t>(std::popcount(mask));
+        pending.fetch_or(mask, std::memory_order_acq_rel);
+        lastMask.store(mask, std::memory_order_relaxed);
+        jointCount.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+
+        Bump(counters.updates, 1);
+        Bump(counters.jointsProcessed, changed);
+        Bump(counters.jointsSkipped, count - changed);
+    }
+
+    // Everything changed since the previous call, consumer side
+    uint32_t Consume()
+    {
+        const auto mask = pending.exchange(0, std::memory_order_acq_rel);
+        const auto count = jointCount.load(std::memory_order_relaxed);
+
+        Bump(counters.consumerPolls, 1);
+        if (mask == 0) Bump(counters.copiesSkipped, 1);
+        Bump(counters.consumerJointsSkipped, count - (std::min)(count, static_cast<uint32_t>(std::popcount(mask))));
+        return mask;
+    }
+
+    [[nodiscard]] uint32_t LastMask() const
+    {
+        return lastMask.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Stats CurrentStats() const
+    {
+        return {
+            .updates = counters.updates.load(std::memory_order_relaxed),
+            .jointsProcessed = counters.jointsProcessed.load(std::memory_order_relaxed),
+            .jointsSkipped = counters.jointsSkipped.load(std::memory_order_relaxed),
+            .consumerPolls = counters.consumerPolls.load(std::memory_order_relaxed),
+            .copiesSkipped = counters.copiesSkipped.load(std::memory_order_relaxed),
+            .consumerJointsSkipped = counters.consumerJointsSkipped.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    [[nodiscard]] bool AtRest(const ovrPoseStatef& pose) const
+    {
+        const auto& v = pose.LinearVelocity;
+        const auto& w = pose.AngularVelocity;
+        return v.x * v.x + v.y * v.y + v.z * v.z < restSpeed * restSpeed &&
+            w.x * w.x + w.y * w.y + w.z * w.z < restAngularSpeed * restAngularSpeed;
+    }
+
+    // Single writer per counter, readers only want a rough figure
+    static void Bump(std::atomic<uint64_t>& counter, const uint64_t by)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    float positionEpsilonSq = -1.f;
+    float orientationDot = 2.f;
+    bool invalidated = true;
+
+    std::array<ovrPoseStatef, MaxJoints> reference{};
+
+    std::atomic<uint32_t> pending{0};
+    std::atomic<uint32_t> lastMask{0};
+    std::atomic<uint32_t> jointCount{0};
+
+    struct
+    {
+        std::atomic<uint64_t> updates{0}, jointsProcessed{0}, jointsSkipped{0};
+        std::atomic<uint64_t> consumerPolls{0}, copiesSkipped{0}, consumerJointsSkipped{0};
+    } counters;
+};
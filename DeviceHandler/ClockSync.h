@@ -0,0 +1,100 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+
+// Maps OVR time onto the host steady clock (QPC on Windows) with a running
+// linear fit host = offset + rate * ovr, fed from bracketed clock reads
+class ClockSync
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    double smoothing = 0.01; // Weight of each new pair in the fit (~100 pair memory)
+    double maxBracket = 50e-6; // [s] Pairs read slower than this are thrown away
+
+    struct Stats
+    {
+        double offset = 0.0; // [s] Host minus OVR time, right now
+        double driftPpm = 0.0; // How much faster the OVR clock runs
+        double residualUs = 0.0; // RMS of the pairs around the fit
+        double bracketUs = 0.0; // Tightest clock read bracket seen
+        uint64_t pairs = 0; // Pairs folded into the fit
+        uint64_t rejected = 0; // Pairs thrown away for a wide bracket
+    };
+
+    // Host time the OVR clock read <ovr> between <before> and <after>
+    void Observe(const double ovr, const clock::time_point before, const clock::time_point after)
+    {
+        const double bracket = std::chrono::duration<double>(after - before).count();
+        const double host = Seconds(before) + bracket * 0.5; // Assume the read landed mid-way
+        minBracket = (std::min)(minBracket, bracket);
+
+        // Preempted or migrated in between, the midpoint can't be trusted
+        if (bracket > maxBracket && bracket > minBracket * 2.0)
+        {
+            stats.rejected++;
+            return;
+        }
+
+        if (stats.pairs++ == 0)
+        {
+            meanOvr = ovr;
+            meanHost = host;
+        }
+
+        // Exponentially weighted means and co-moments, no large sums to lose precision in
+        const double dx = ovr - meanOvr;
+        const double dy = host - meanHost;
+        meanOvr += smoothing * dx;
+        meanHost += smoothing * dy;
+        varOvr = (1.0 - smoothing) * (varOvr + smoothing * dx * dx);
+        covariance = (1.0 - smoothing) * (covariance + smoothing * dx * dy);
+
+        // Only trust the slope once the pairs span a little time
+        const double rate = varOvr > 1e-4 ? covariance / varOvr : 1.0;
+        const double residual = host - (meanHost + rate * (ovr - meanOvr));
+        residualSq = (1.0 - smoothing) * residualSq + smoothing * residual * residual;
+
+        stats.offset = host - ovr;
+        stats.driftPpm = (1.0 / rate - 1.0) * 1e6;
+        stats.residualUs = std::sqrt(residualSq) * 1e6;
+        stats.bracketUs = minBracket * 1e6;
+
+        fit.Store({.meanOvr = meanOvr, .meanHost = meanHost, .rate = rate});
+        published.Store(stats);
+    }
+
+    // OVR seconds to host steady clock seconds, safe from any thread
+    [[nodiscard]] double ToHost(const double ovr) const
+    {
+        const auto current = fit.Load();
+        return current.meanHost + current.rate * (ovr - current.meanOvr);
+    }
+
+    [[nodiscard]] Stats CurrentStats() const
+    {
+        return published.Load();
+    }
+
+    // Host steady clock seconds for <time>
+    static double Seconds(const clock::time_point time)
+    {
+        return std::chrono::duration<double>(time.time_since_epoch()).count();
+    }
+
+private:
+    struct Fit
+    {
+        double meanOvr = 0.0, meanHost = 0.0, rate = 1.0;
+    };
+
+    // Update thread only
+    double meanOvr = 0.0, meanHost = 0.0;
+    double varOvr = 0.0, covariance = 0.0, residualSq = 0.0;
+    double minBracket = (std::numeric_limits<double>::max)();
+    Stats stats{};
+
+    AtomicSnapshot<Fit> fit;
+    AtomicSnapshot<Stats> published;
+};
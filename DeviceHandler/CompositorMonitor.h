@@ -0,0 +1,178 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+#include "StallWatchdog.h"
+#include "ThreadLauncher.h"
+#include <OVR_CAPI.h>
+
+// Collects ovr_GetPerfStats on a worker thread and folds it into
+// fixed-length rolling windows, kept in a bounded history ring
+class CompositorMonitor
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Window
+    {
+        double seconds = 0.0; // Actual window length
+        uint32_t frames = 0; // Compositor frames seen
+        uint32_t compositorDropped = 0; // Frames the compositor missed
+        uint32_t appDropped = 0; // Frames we've submitted too late
+        double latencySum = 0.0; // App motion-to-photon, summed [s]
+        double latencyMax = 0.0; // App motion-to-photon, worst [s]
+        double queueAheadSum = 0.0; // App queue-ahead time, summed [s]
+        bool aswActive = false; // ASW was engaged at least once
+        uint32_t aswToggles = 0; // ASW activation changes
+        bool overflow = false; // The runtime dropped stats in between polls
+    };
+
+    static constexpr size_t HistoryLength = 60;
+    clock::duration pollInterval = std::chrono::milliseconds(25); // The runtime only keeps 5 frames
+    clock::duration windowLength = std::chrono::seconds(1);
+
+    CompositorMonitor() = default;
+    CompositorMonitor(const CompositorMonitor&) = delete;
+    CompositorMonitor& operator=(const CompositorMonitor&) = delete;
+
+    ~CompositorMonitor()
+    {
+        Stop();
+    }
+
+    // Start polling <session> on a worker thread, restarts if already running
+    void Start(const ovrSession session, StallWatchdog& stallWatchdog)
+    {
+        Stop();
+
+        polledSession = session;
+        watchdog = &stallWatchdog;
+        windowStart = {};
+        current = {};
+        lastCompositorFrame = -1;
+
+        stopRequested = false;
+        worker = ThreadLauncher::Launch("Compositor monitor", ThreadLauncher::Role::Worker, [this]
+        {
+            auto next = clock::now();
+            while (!stopRequested)
+            {
+                Poll(clock::now());
+                next += pollInterval;
+                ThreadLauncher::SleepUntil(next);
+            }
+        });
+    }
+
+    // The session must outlive the worker
+    void Stop()
+    {
+        stopRequested = true;
+        if (worker.joinable()) worker.join();
+    }
+
+    // Copy the history out, oldest first, safe from any thread
+    [[nodiscard]] std::vector<Window> History() const
+    {
+        const auto head = written.load(std::memory_order_acquire);
+        const auto count = (std::min)(head, static_cast<uint64_t>(HistoryLength));
+
+        std::vector<Window> result;
+        result.reserve(count);
+
+        for (auto i = head - count; i < head; i++)
+        {
+            const auto entry = history[i % history.size()].Load();
+            if (entry.index == i) result.push_back(entry.window); // Skip any lapped while reading
+        }
+
+        return result;
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t index = 0;
+        Window window{};
+    };
+
+    // Poll the runtime and fold its frames in, worker thread only
+    // Skipped while the runtime is being backed off, the frames are just missed
+    void Poll(const clock::time_point now)
+    {
+        if (!watchdog->ShouldRun(StallWatchdog::Call::PerfStats, now)) return;
+
+        ovrPerfStats stats{};
+        bool valid = false;
+        watchdog->Time(StallWatchdog::Call::PerfStats, [&, this]
+        {
+            valid = OVR_SUCCESS(ovr_GetPerfStats(polledSession, &stats));
+        });
+
+        if (!valid) return;
+
+        if (windowStart == clock::time_point{}) windowStart = now;
+        current.overflow |= stats.AnyFrameStatsDropped == ovrTrue;
+
+        // The frame index starts over when the runtime restarts, so take the counters from scratch
+        if (stats.FrameStatsCount > 0 && stats.FrameStats[0].CompositorFrameIndex < lastCompositorFrame)
+            lastCompositorFrame = -1;
+
+        // FrameStats[0] is the most recent, walk them oldest-first
+        for (int i = stats.FrameStatsCount - 1; i >= 0; i--)
+        {
+            const auto& frame = stats.FrameStats[i];
+            if (frame.CompositorFrameIndex <= lastCompositorFrame) continue;
+
+            // The counters are cumulative, though they may reset with the runtime
+            const auto delta = [](const int value, const int last) { return static_cast<uint32_t>((std::max)(0, value - last)); };
+
+            if (lastCompositorFrame >= 0)
+            {
+                current.compositorDropped += delta(frame.CompositorDroppedFrameCount, lastCompositorDropped);
+                current.appDropped += delta(frame.AppDroppedFrameCount, lastAppDropped);
+                current.aswToggles += delta(frame.AswActivatedToggleCount, lastAswToggles);
+            }
+
+            lastCompositorFrame = frame.CompositorFrameIndex;
+            lastCompositorDropped = frame.CompositorDroppedFrameCount;
+            lastAppDropped = frame.AppDroppedFrameCount;
+            lastAswToggles = frame.AswActivatedToggleCount;
+
+            current.frames++;
+            current.latencySum += frame.AppMotionToPhotonLatency;
+            current.latencyMax = (std::max)(current.latencyMax, static_cast<double>(frame.AppMotionToPhotonLatency));
+            current.queueAheadSum += frame.AppQueueAheadTime;
+            current.aswActive |= frame.AswIsActive == ovrTrue;
+        }
+
+        if (now - windowStart < windowLength) return;
+
+        // Close the window and push it to the history
+        current.seconds = std::chrono::duration<double>(now - windowStart).count();
+
+        const auto index = written.load(std::memory_order_relaxed);
+        history[index % history.size()].Store({.index = index, .window = current});
+        written.store(index + 1, std::memory_order_release);
+
+        current = {};
+        windowStart = now;
+    }
+
+    ovrSession polledSession = nullptr;
+    StallWatchdog* watchdog = nullptr;
+    std::thread worker;
+    std::atomic<bool> stopRequested{false};
+
+    // Worker thread only
+    clock::time_point windowStart{};
+    Window current{};
+
+    int lastCompositorFrame = -1;
+    int lastCompositorDropped = 0;
+    int lastAppDropped = 0;
+    int lastAswToggles = 0;
+
+    std::array<AtomicSnapshot<Entry>, HistoryLength + 1> history; // One spare for the slot being written
+    std::atomic<uint64_t> written{0};
+};
@@ -0,0 +1,144 @@
+#pragma once
+#include <pch.h>
+
+#include "Win32_DirectXAppUtil.h"
+#include <OVR_CAPI.h>
+
+// Per-joint tracking dropout handler: passes tracked poses through,
+// dead-reckons short dropouts from the last known motion with decaying
+// confidence, holds the pose once lost, and blends back on reacquisition
+class DropoutFilter
+{
+public:
+    enum class State
+    {
+        Lost,
+        Inferred,
+        Tracked
+    };
+
+    double maxDropout = 0.5; // [s] Extrapolate for at most this long
+    double decayTime = 0.15; // [s] Velocity e-folding time while extrapolating
+    double blendTime = 0.1; // [s] Blend back to the measurement over this long
+
+    // Feed the latest measurement, returns the pose to export
+    // <time> is the sample time in OVR seconds, used for untracked samples too
+    const ovrPoseStatef& Update(const ovrPoseStatef& measured, const bool tracked, const double time)
+    {
+        if (tracked)
+        {
+            if (state != State::Tracked && hasGood)
+            {
+                blendFrom = output; // Reacquired, ease back in from where we were
+                blendStart = time;
+            }
+
+            state = State::Tracked;
+            confidence = 1.f;
+            lastGood = measured;
+            lastGoodTime = time;
+            hasGood = true;
+
+            output = measured;
+            const double alpha = blendTime > 0.0 ? (time - blendStart) / blendTime : 1.0;
+            if (alpha < 1.0) Blend(static_cast<float>(alpha));
+            return output;
+        }
+
+        if (!hasGood)
+        {
+            state = State::Lost;
+            confidence = 0.f;
+            return output; // Nothing to go on yet
+        }
+
+        const double elapsed = time - lastGoodTime;
+        if (elapsed > maxDropout)
+        {
+            // Give up, hold still where we've ended up
+            state = State::Lost;
+            confidence = 0.f;
+            output.LinearVelocity = output.AngularVelocity = {};
+            output.LinearAcceleration = output.AngularAcceleration = {};
+            return output;
+        }
+
+        state = State::Inferred;
+        confidence = static_cast<float>(1.0 - elapsed / maxDropout);
+        Extrapolate(static_cast<float>((std::max)(elapsed, 0.0)));
+        return output;
+    }
+
+    [[nodiscard]] State CurrentState() const { return state; }
+    [[nodiscard]] float Confidence() const { return confidence; }
+
+    // Tracked and done blending, the output is just the measurement
+    [[nodiscard]] bool IsSettled(const double time) const
+    {
+        return state == State::Tracked && time - blendStart >= blendTime;
+    }
+
+private:
+    // Integrate the last known motion with exponentially decaying velocity
+    void Extrapolate(const float elapsed)
+    {
+        const float tau = static_cast<float>(decayTime);
+        const float decay = std::exp(-elapsed / tau);
+        const float travel = tau * (1.f - decay); // Integral of the decay over <elapsed>
+        const float accelerationTime = (std::min)(elapsed, tau);
+
+        const XMVECTOR velocity = Load(lastGood.LinearVelocity);
+        const XMVECTOR acceleration = Load(lastGood.LinearAcceleration);
+        const XMVECTOR position = XMVectorAdd(
+            XMVectorAdd(Load(lastGood.ThePose.Position), XMVectorScale(velocity, travel)),
+            XMVectorScale(acceleration, 0.5f * accelerationTime * accelerationTime));
+
+        // Angular velocity is in world space, so the delta goes on the left
+        const XMVECTOR angularVelocity = Load(lastGood.AngularVelocity);
+        const float angularSpeed = XMVectorGetX(XMVector3Length(angularVelocity));
+        XMVECTOR orientation = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&lastGood.ThePose.Orientation));
+        if (angularSpeed > 1e-6f)
+            orientation = XMQuaternionMultiply(orientation, XMQuaternionRotationNormal(
+                                                   XMVectorScale(angularVelocity, 1.f / angularSpeed),
+                                                   angularSpeed * travel));
+
+        Store(output.ThePose.Position, position);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&output.ThePose.Orientation), XMQuaternionNormalize(orientation));
+        Store(output.LinearVelocity, XMVectorScale(velocity, decay));
+        Store(output.AngularVelocity, XMVectorScale(angularVelocity, decay));
+        output.LinearAcceleration = output.AngularAcceleration = {};
+        output.TimeInSeconds = lastGood.TimeInSeconds + elapsed;
+    }
+
+    // Ease the output from <blendFrom> towards the measurement
+    void Blend(const float alpha)
+    {
+        Store(output.ThePose.Position, XMVectorLerp(
+                  Load(blendFrom.ThePose.Position), Load(output.ThePose.Position), alpha));
+
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&output.ThePose.Orientation), XMQuaternionSlerp(
+                          XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&blendFrom.ThePose.Orientation)),
+                          XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&output.ThePose.Orientation)), alpha));
+    }
+
+    static XMVECTOR Load(const ovrVector3f& v)
+    {
+        return XMVectorSet(v.x, v.y, v.z, 0.f);
+    }
+
+    static void Store(ovrVector3f& v, const FXMVECTOR value)
+    {
+        XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(&v), value);
+    }
+
+    State state = State::Lost;
+    float confidence = 0.f;
+    bool hasGood = false;
+
+    ovrPoseStatef lastGood{};
+    double lastGoodTime = 0.0;
+
+    ovrPoseStatef output{};
+    ovrPoseStatef blendFrom{};
+    double blendStart = -1.0;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <pch.h>
+
+#include <condition_variable>
+
+#include "ThreadLauncher.h"
+
+// Runs frame submission on a thread of its own, so a runtime stalling in
+// ovr_SubmitFrame never holds Update() up: the host hands a frame over and
+// carries on, frames coming in while the last one is still out are skipped
+class FrameSubmitter
+{
+public:
+    FrameSubmitter() = default;
+    FrameSubmitter(const FrameSubmitter&) = delete;
+    FrameSubmitter& operator=(const FrameSubmitter&) = delete;
+
+    ~FrameSubmitter()
+    {
+        Stop();
+    }
+
+    // Start running <submit> on request, restarts if already running
+    void Start(std::function<void()> submit)
+    {
+        Stop();
+        job = std::move(submit);
+
+        {
+            std::lock_guard lock(mutex);
+            stopRequested = false;
+            pending = false;
+        }
+
+        worker = ThreadLauncher::Launch("Frame submitter", ThreadLauncher::Role::Worker, [this] { Run(); });
+    }
+
+    // Waits for a submission in flight to return, the session must outlive it
+    void Stop()
+    {
+        if (!worker.joinable()) return;
+
+        {
+            std::lock_guard lock(mutex);
+            stopRequested = true;
+        }
+
+        wake.notify_all();
+        worker.join();
+    }
+
+    // Hand a frame over, returns false (and counts it) if the last one's still out
+    bool Request()
+    {
+        {
+            std::lock_guard lock(mutex);
+            if (stopRequested || !worker.joinable()) return false;
+
+            if (pending)
+            {
+                skipped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            pending = true;
+            requestedAt = ThreadLauncher::clock::now();
+        }
+
+        wake.notify_one();
+        return true;
+    }
+
+    // Frames skipped because a submission was still in flight, safe from any thread
+    [[nodiscard]] uint64_t Skipped() const
+    {
+        return skipped.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Run()
+    {
+        while (true)
+        {
+            ThreadLauncher::clock::time_point due;
+
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [this] { return stopRequested || pending; });
+                if (stopRequested) return;
+                due = requestedAt;
+            }
+
+            ThreadLauncher::MarkWake(due); // How long the frame took to get picked up
+            job();
+
+            std::lock_guard lock(mutex);
+            pending = false;
+        }
+    }
+
+    std::function<void()> job;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    // Under <mutex>
+    bool stopRequested = false;
+    bool pending = false;
+    ThreadLauncher::clock::time_point requestedAt{};
+
+    std::atomic<uint64_t> skipped{0};
+};
@@ -0,0 +1,128 @@
+#pragma once
+#include <pch.h>
+
+#include <OVR_CAPI.h>
+
+// Caches the play area polygon and answers batched per-joint proximity queries
+// Edges are kept as a structure of arrays so the inner loop vectorizes
+class GuardianBoundary
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    clock::duration refreshInterval = std::chrono::seconds(1);
+
+    // Re-read the boundary if the interval's passed, only rebuilds on change
+    // Returns true if the cached polygon has just been replaced
+    bool Refresh(const ovrSession session, const clock::time_point now)
+    {
+        if (now - lastRefresh < refreshInterval) return false;
+        lastRefresh = now;
+
+        int count = 0;
+        if (!OVR_SUCCESS(ovr_GetBoundaryGeometry(session, ovrBoundary_PlayArea, nullptr, &count)) || count < 0)
+            count = 0;
+
+        scratch.resize(count);
+        if (count > 0 && !OVR_SUCCESS(ovr_GetBoundaryGeometry(
+            session, ovrBoundary_PlayArea, scratch.data(), &count)))
+            count = 0;
+
+        scratch.resize(count);
+        if (scratch.size() == points.size() && std::equal(
+            scratch.begin(), scratch.end(), points.begin(), [](const ovrVector3f& a, const ovrVector3f& b)
+            {
+                return a.x == b.x && a.y == b.y && a.z == b.z;
+            }))
+            return false; // Nothing's changed
+
+        points.swap(scratch);
+        Rebuild();
+        return true;
+    }
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return !ax.empty();
+    }
+
+    [[nodiscard]] size_t EdgeCount() const
+    {
+        return ax.size();
+    }
+
+    // Signed horizontal distance to the boundary (positive inside) and the closest
+    // boundary point for each of <count> joints, infinity if there's no boundary
+    void Query(const float* px, const float* pz, const size_t count,
+               float* distance, float* cx, float* cz) const
+    {
+        const size_t edges = ax.size();
+        for (size_t j = 0; j < count; j++)
+        {
+            const float x = px[j], z = pz[j];
+            float best = std::numeric_limits<float>::infinity();
+            float bestX = x, bestZ = z;
+            bool inside = false;
+
+            for (size_t e = 0; e < edges; e++)
+            {
+                // Closest point on the segment
+                const float rx = x - ax[e], rz = z - az[e];
+                const float t = std::clamp((rx * dx[e] + rz * dz[e]) * invLength[e], 0.f, 1.f);
+                const float qx = ax[e] + t * dx[e], qz = az[e] + t * dz[e];
+                const float d2 = (x - qx) * (x - qx) + (z - qz) * (z - qz);
+
+                const bool closer = d2 < best;
+                best = closer ? d2 : best;
+                bestX = closer ? qx : bestX;
+                bestZ = closer ? qz : bestZ;
+
+                // Even-odd crossing test, both sides evaluated so it stays branchless
+                const bool straddles = (az[e] > z) != (az[e] + dz[e] > z);
+                inside ^= straddles & (x < ax[e] + rz * slope[e]);
+            }
+
+            distance[j] = edges ? (inside ? 1.f : -1.f) * std::sqrt(best) : best;
+            cx[j] = bestX;
+            cz[j] = bestZ;
+        }
+    }
+
+    [[nodiscard]] float FloorHeight() const
+    {
+        return points.empty() ? 0.f : points.front().y;
+    }
+
+private:
+    void Rebuild()
+    {
+        const size_t count = points.size() >= 3 ? points.size() : 0;
+        ax.resize(count);
+        az.resize(count);
+        dx.resize(count);
+        dz.resize(count);
+        invLength.resize(count);
+        slope.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const auto& a = points[i];
+            const auto& b = points[(i + 1) % count];
+
+            ax[i] = a.x;
+            az[i] = a.z;
+            dx[i] = b.x - a.x;
+            dz[i] = b.z - a.z;
+
+            const float lengthSq = dx[i] * dx[i] + dz[i] * dz[i];
+            invLength[i] = lengthSq > 0.f ? 1.f / lengthSq : 0.f;
+            slope[i] = dz[i] != 0.f ? dx[i] / dz[i] : 0.f; // Horizontal edges never straddle
+        }
+    }
+
+    clock::time_point lastRefresh{};
+    std::vector<ovrVector3f> points, scratch;
+
+    // Edge i goes from (ax, az) to (ax + dx, az + dz), slope is dx / dz
+    std::vector<float> ax, az, dx, dz, invLength, slope;
+};
@@ -35,16 +35,16 @@ public:
                     Log(L"DIRECTX.InitWindow failed", 2);
 
                 // Use HMD desc to initialize device
-                ovrHmdDesc hmdDesc = ovr_GetHmdDesc(mSession);
-                if (!DIRECTX.InitDevice(hmdDesc.Resolution.w / 2,
-                                        hmdDesc.Resolution.h / 2,
+                mHmdDesc = ovr_GetHmdDesc(mSession);
+                if (!DIRECTX.InitDevice(mHmdDesc.Resolution.w / 2,
+                                        mHmdDesc.Resolution.h / 2,
                                         reinterpret_cast<LUID*>(&luid)))
                     Log(L"DIRECTX.InitDevice failed", 2);
 
                 // Use FloorLevel tracking origin
                 ovr_SetTrackingOriginType(mSession, ovrTrackingOrigin_FloorLevel);
 
-                InitRenderTargets(hmdDesc);
+                InitRenderTargets(mHmdDesc);
                 vrObjects = (ovr_GetConnectedControllerTypes(mSession) >> 8) & 0xf;
 
                 // Main Loop
@@ -63,13 +63,18 @@ public:
 
     void InitRenderTargets(const ovrHmdDesc& hmdDesc)
     {
+        mRenderTargetBytes = 0;
+
         // For each eye
         for (int i = 0; i < ovrEye_Count; ++i)
         {
-            // Viewport
-            const ovrSizei idealSize = ovr_GetFovTextureSize(
+            // Viewport, sized by the requested pixel density
+            ovrSizei idealSize = ovr_GetFovTextureSize(
                 mSession, static_cast<ovrEyeType>(i),
-                hmdDesc.DefaultEyeFov[i], 1.0f);
+                hmdDesc.DefaultEyeFov[i], pixelDensity);
+
+            idealSize.w = (std::max)(idealSize.w, 16);
+            idealSize.h = (std::max)(idealSize.h, 16);
 
             mEyeRenderViewport[i] = {
                 0, 0, idealSize.w, idealSize.h
@@ -117,6 +122,9 @@ public:
                 renderTexture->Release();
             }
 
+            // Color (RGBA8) for every swap chain buffer, plus one D32 depth target
+            mRenderTargetBytes += static_cast<uint64_t>(idealSize.w) * idealSize.h * 4 * (textureCount + 1);
+
             // DirectX 11 - Generate Depth
             // ----------------------------------------------------------------------
             D3D11_TEXTURE2D_DESC depthTextureDesc = {
@@ -131,6 +139,46 @@ public:
         }
     }
 
+    void ReleaseRenderTargets()
+    {
+        for (int i = 0; i < ovrEye_Count; ++i)
+        {
+            for (auto& renderTargetView : mEyeRenderTargets[i])
+                Release(renderTargetView);
+
+            mEyeRenderTargets[i].clear();
+            Release(mEyeDepthTarget[i]);
+
+            if (mTextureChain[i])
+            {
+                ovr_DestroyTextureSwapChain(mSession, mTextureChain[i]);
+                mTextureChain[i] = nullptr;
+            }
+        }
+
+        mRenderTargetBytes = 0;
+    }
+
+    // Rebuild swap chains and viewports for a new pixel density, Render() thread only
+    void SetPixelDensity(const float density)
+    {
+        if (density == pixelDensity) return;
+        pixelDensity = density;
+
+        ReleaseRenderTargets();
+        InitRenderTargets(mHmdDesc);
+    }
+
+    [[nodiscard]] ovrSizei RenderTargetSize() const
+    {
+        return mEyeRenderViewport[ovrEye_Left].Size;
+    }
+
+    [[nodiscard]] uint64_t RenderTargetBytes() const
+    {
+        return mRenderTargetBytes;
+    }
+
     void Render()
     {
         // Get current eye pose for rendering
@@ -173,12 +221,15 @@ public:
 
     DirectX11 DIRECTX;
     uint32_t vrObjects;
+    float pixelDensity = 1.0f; // Eye target density, set before start_ovr
     ovrSession mSession = nullptr;
 
 private:
     HRESULT& m_result;
 
     uint32_t mFrameIndex = 0; // Global frame counter
+    uint64_t mRenderTargetBytes = 0; // Eye color and depth targets, in total
+    ovrHmdDesc mHmdDesc = {};
     ovrPosef mHmdToEyePose[ovrEye_Count] = {}; // Offset from the center of the HMD to each eye
     ovrRecti mEyeRenderViewport[ovrEye_Count] = {}; // Eye render target viewport
 
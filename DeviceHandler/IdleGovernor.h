@@ -0,0 +1,157 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+#include <OVR_CAPI.h>
+
+// Decides whether the handler runs at full host rate or may throttle
+// frame submission and pose sampling down while nothing is happening
+class IdleGovernor
+{
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr size_t MaxProbes = 4; // Headset, both hands and an object
+
+    enum class State
+    {
+        Active,
+        Idle
+    };
+
+    float linearThreshold = 0.01f; // [m] Moving further than this counts as movement
+    float angularThreshold = 0.05f; // [rad] Turning further than this counts as movement
+    clock::duration idleAfter = std::chrono::seconds(10); // Inactivity needed to go idle
+    clock::duration idleInterval = std::chrono::milliseconds(500); // Work interval while idle
+
+    // Device poses to look for movement in, untracked ones are left out
+    struct Probe
+    {
+        std::array<ovrPosef, MaxProbes> poses{};
+        std::array<bool, MaxProbes> tracked{};
+    };
+
+    struct Stats
+    {
+        State state = State::Active;
+        uint32_t transitions = 0;
+        double activeSeconds = 0.0;
+        double idleSeconds = 0.0;
+    };
+
+    // Feed this frame's probe, returns true if this frame should do full work
+    // Probes are cheap pose reads, only the render, submit and export work gets throttled
+    // Movement, a mounted HMD or a consumer reading again after a gap wake us up immediately,
+    // a consumer that keeps reading every frame doesn't keep us awake on its own
+    bool Evaluate(const clock::time_point now, const Probe& probe, const bool hmdMounted, const bool enabled)
+    {
+        if (lastEvaluation == clock::time_point{}) lastEvaluation = now;
+
+        const auto read = lastConsumerRead.load(std::memory_order_relaxed);
+        const bool consumerActive = now - read < idleAfter;
+        const bool consumerReturned = read - lastSeenRead >= idleAfter; // First read after a gap
+        lastSeenRead = read;
+
+        if (Displaced(probe)) lastMotion = now;
+        const bool moving = now - lastMotion < idleInterval; // Bridges the frames in between steps
+
+        if (moving || hmdMounted || consumerReturned) lastActivity = now;
+
+        // Account the elapsed time to the state we've been in until now
+        (state == State::Active ? activeTime : idleTime) += now - lastEvaluation;
+        lastEvaluation = now;
+
+        const bool shouldIdle = enabled && !moving && !hmdMounted &&
+            (now - lastActivity >= idleAfter || !consumerActive);
+
+        bool work = true;
+        if (!shouldIdle)
+        {
+            if (state == State::Idle) transitions++;
+            state = State::Active;
+        }
+        else if (state == State::Active)
+        {
+            transitions++;
+            state = State::Idle;
+            lastIdleWork = now; // Finish this frame at full rate
+        }
+        else if (now - lastIdleWork < idleInterval) work = false; // Throttled
+        else lastIdleWork = now;
+
+        published.Store({
+            .state = state, .transitions = transitions,
+            .activeSeconds = std::chrono::duration<double>(activeTime).count(),
+            .idleSeconds = std::chrono::duration<double>(idleTime).count()
+        });
+
+        return work;
+    }
+
+    // Mark that somebody has just read the poses (callable from any thread)
+    void MarkConsumerRead(const clock::time_point now) const
+    {
+        lastConsumerRead.store(now, std::memory_order_relaxed);
+    }
+
+    // Update thread only
+    [[nodiscard]] State CurrentState() const { return state; }
+
+    // Latest figures, safe from any thread
+    [[nodiscard]] Stats CurrentStats() const
+    {
+        return published.Load();
+    }
+
+private:
+    // Check if any device has moved away from where we last saw it move
+    // Measuring from there rather than the last frame catches slow drifts too
+    bool Displaced(const Probe& probe)
+    {
+        bool moved = false;
+        for (size_t i = 0; i < MaxProbes; i++)
+        {
+            if (!probe.tracked[i]) continue;
+
+            const auto& pose = probe.poses[i];
+            if (anchored[i] && !Exceeds(anchors[i], pose)) continue;
+
+            moved |= anchored[i]; // The first sighting only sets the anchor
+            anchors[i] = pose;
+            anchored[i] = true;
+        }
+
+        return moved;
+    }
+
+    [[nodiscard]] bool Exceeds(const ovrPosef& from, const ovrPosef& to) const
+    {
+        const float dx = to.Position.x - from.Position.x;
+        const float dy = to.Position.y - from.Position.y;
+        const float dz = to.Position.z - from.Position.z;
+        if (dx * dx + dy * dy + dz * dz > linearThreshold * linearThreshold) return true;
+
+        const float dot = std::abs(from.Orientation.x * to.Orientation.x + from.Orientation.y * to.Orientation.y +
+            from.Orientation.z * to.Orientation.z + from.Orientation.w * to.Orientation.w);
+        return 2.f * std::acos((std::min)(dot, 1.f)) > angularThreshold;
+    }
+
+    // Update thread only
+    State state = State::Active;
+    uint32_t transitions = 0;
+
+    clock::duration activeTime{};
+    clock::duration idleTime{};
+
+    std::array<ovrPosef, MaxProbes> anchors{};
+    std::array<bool, MaxProbes> anchored{};
+
+    clock::time_point lastEvaluation{};
+    clock::time_point lastMotion{};
+    clock::time_point lastActivity = clock::now();
+    clock::time_point lastIdleWork{};
+    clock::time_point lastProbe{};
+    clock::time_point lastSeenRead = clock::now(); // Consumer read seen by the last evaluation
+    mutable std::atomic<clock::time_point> lastConsumerRead = lastSeenRead;
+
+    AtomicSnapshot<Stats> published;
+};
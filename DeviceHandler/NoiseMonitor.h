@@ -0,0 +1,253 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+#include <OVR_CAPI.h>
+
+// Running noise figures for one joint over a sliding window of tracked samples:
+// jitter at rest, sample-to-sample deltas, velocity noise and sample intervals
+class NoiseMonitor
+{
+public:
+    static constexpr size_t Window = 256; // Samples kept in the window
+    static constexpr size_t PublishEvery = 16; // Samples between snapshots
+
+    float restSpeed = 0.01f; // [m/s] Slower than this counts as at rest
+    float restAngularSpeed = 0.05f; // [rad/s] Slower than this counts as at rest
+
+    struct Stats
+    {
+        uint32_t samples = 0; // Tracked samples in the window
+        float restShare = 0.f; // Fraction of them at rest
+        double positionJitterMm = 0.0; // RMS positional noise at rest
+        double angularJitterDeg = 0.0; // RMS angular noise at rest
+        double deltaMeanMm = 0.0, deltaStdMm = 0.0; // Sample-to-sample translation
+        double angleDeltaMeanDeg = 0.0, angleDeltaStdDeg = 0.0; // Sample-to-sample rotation
+        double velocityNoiseMms = 0.0; // RMS of reported minus differentiated velocity
+        double intervalMeanMs = 0.0, intervalStdMs = 0.0; // Between tracked samples
+        double intervalP50Ms = 0.0, intervalP99Ms = 0.0; // Bucket resolution, the true max past the histogram
+        double intervalMaxMs = 0.0; // Exact
+        uint32_t intervalOverflows = 0; // Intervals too long for the histogram
+    };
+
+    // Feed this frame's raw pose, untracked samples only break the sequence
+    void Add(const ovrPoseStatef& pose, const bool tracked, const double time)
+    {
+        if (!tracked)
+        {
+            state.hasPrevious = false;
+            return;
+        }
+
+        if (!state.hasPrevious || time <= state.previousTime)
+        {
+            state.previous = pose;
+            state.previousTime = time;
+            state.hasPrevious = true;
+            return;
+        }
+
+        const double dt = time - state.previousTime;
+        Entry entry{.interval = dt * 1000.0};
+
+        // Translation and rotation since the last sample
+        const auto& p = pose.ThePose.Position;
+        const auto& o = state.previous.ThePose.Position;
+        entry.delta = {p.x - o.x, p.y - o.y, p.z - o.z};
+
+        const auto relative = Relative(state.previous.ThePose.Orientation, pose.ThePose.Orientation);
+        const double sine = std::sqrt(
+            relative[0] * relative[0] + relative[1] * relative[1] + relative[2] * relative[2]);
+        entry.turn = {2.0 * relative[0], 2.0 * relative[1], 2.0 * relative[2]}; // Small-angle rotation vector
+        entry.angle = 2.0 * std::atan2(sine, relative[3]);
+        entry.distance = std::sqrt(entry.delta[0] * entry.delta[0] + entry.delta[1] * entry.delta[1] +
+            entry.delta[2] * entry.delta[2]);
+
+        // What the runtime says minus what the positions say
+        const auto& v = pose.LinearVelocity;
+        entry.velocityResidual = {v.x - entry.delta[0] / dt, v.y - entry.delta[1] / dt, v.z - entry.delta[2] / dt};
+
+        const auto& w = pose.AngularVelocity;
+        entry.atRest = Length(v) < restSpeed && Length(w) < restAngularSpeed;
+
+        if (state.count == Window) Apply(state.entries[state.head], -1); // Slide the oldest one out
+        else state.count++;
+
+        state.entries[state.head] = entry;
+        Apply(entry, +1);
+        state.head = (state.head + 1) % Window;
+
+        state.previous = pose;
+        state.previousTime = time;
+
+        if (++state.sincePublish >= PublishEvery)
+        {
+            state.sincePublish = 0;
+            snapshot.Store(Summarize());
+        }
+    }
+
+    // Drop everything collected so far
+    void Reset()
+    {
+        state = {};
+        snapshot.Store({});
+    }
+
+    // Latest published figures, safe from any thread
+    [[nodiscard]] Stats CurrentStats() const
+    {
+        return snapshot.Load();
+    }
+
+private:
+    static constexpr double BucketMs = 0.25; // Interval histogram resolution
+    static constexpr size_t Buckets = 128; // The last one takes everything past the range, unsorted
+
+    // Windowed mean and variance, samples can be taken back out
+    struct Welford
+    {
+        double n = 0.0, mean = 0.0, m2 = 0.0;
+
+        void Add(const double x, const int sign)
+        {
+            if (sign < 0 && n <= 1.0)
+            {
+                *this = {}; // Took the last one out
+                return;
+            }
+
+            n += sign;
+            const double delta = x - mean;
+            mean += sign * delta / n;
+            m2 = (std::max)(m2 + sign * delta * (x - mean), 0.0);
+        }
+
+        [[nodiscard]] double Variance() const
+        {
+            return n > 1.0 ? m2 / (n - 1.0) : 0.0;
+        }
+    };
+
+    // Per-axis accumulators, variances add up into one figure
+    struct Welford3
+    {
+        std::array<Welford, 3> axes{};
+
+        void Add(const std::array<double, 3>& x, const int sign)
+        {
+            for (size_t a = 0; a < 3; a++) axes[a].Add(x[a], sign);
+        }
+
+        [[nodiscard]] double Deviation() const
+        {
+            return std::sqrt(axes[0].Variance() + axes[1].Variance() + axes[2].Variance());
+        }
+    };
+
+    struct Entry
+    {
+        double interval = 0.0; // [ms]
+        std::array<double, 3> delta{}, turn{}, velocityResidual{};
+        double distance = 0.0, angle = 0.0;
+        bool atRest = false;
+    };
+
+    void Apply(const Entry& entry, const int sign)
+    {
+        if (entry.atRest)
+        {
+            state.restDelta.Add(entry.delta, sign);
+            state.restTurn.Add(entry.turn, sign);
+        }
+
+        state.distance.Add(entry.distance, sign);
+        state.angle.Add(entry.angle, sign);
+        state.velocity.Add(entry.velocityResidual, sign);
+        state.interval.Add(entry.interval, sign);
+        auto& bucket = state.histogram[Bucket(entry.interval)];
+        bucket = sign > 0 ? bucket + 1 : bucket - 1;
+    }
+
+    [[nodiscard]] Stats Summarize() const
+    {
+        constexpr double degrees = 180.0 / 3.14159265358979323846;
+        constexpr double halfSqrt2 = 0.70710678118654752440; // Differences carry the noise twice
+
+        Stats stats{
+            .samples = static_cast<uint32_t>(state.count),
+            .restShare = state.count
+                             ? static_cast<float>(state.restDelta.axes[0].n / static_cast<double>(state.count))
+                             : 0.f,
+            .positionJitterMm = state.restDelta.Deviation() * halfSqrt2 * 1000.0,
+            .angularJitterDeg = state.restTurn.Deviation() * halfSqrt2 * degrees,
+            .deltaMeanMm = state.distance.mean * 1000.0,
+            .deltaStdMm = std::sqrt(state.distance.Variance()) * 1000.0,
+            .angleDeltaMeanDeg = state.angle.mean * degrees,
+            .angleDeltaStdDeg = std::sqrt(state.angle.Variance()) * degrees,
+            .velocityNoiseMms = state.velocity.Deviation() * 1000.0,
+            .intervalMeanMs = state.interval.mean,
+            .intervalStdMs = std::sqrt(state.interval.Variance())
+        };
+
+        // The histogram is too coarse for the max, and it's capped, so look at the window itself
+        for (size_t i = 0; i < state.count; i++)
+            stats.intervalMaxMs = (std::max)(stats.intervalMaxMs, state.entries[i].interval);
+
+        // Walk the histogram once for the percentiles, the overflow bucket only has the max to go on
+        uint32_t seen = 0;
+        const auto p50 = static_cast<uint32_t>(std::ceil(state.count * 0.5));
+        const auto p99 = static_cast<uint32_t>(std::ceil(state.count * 0.99));
+
+        for (size_t i = 0; i < Buckets; i++)
+        {
+            if (state.histogram[i] == 0) continue;
+            const double upper = i == Buckets - 1 ? stats.intervalMaxMs : static_cast<double>(i + 1) * BucketMs;
+
+            if (seen < p50 && seen + state.histogram[i] >= p50) stats.intervalP50Ms = upper;
+            if (seen < p99 && seen + state.histogram[i] >= p99) stats.intervalP99Ms = upper;
+            seen += state.histogram[i];
+        }
+
+        stats.intervalOverflows = state.histogram[Buckets - 1];
+        return stats;
+    }
+
+    // Rotation taking <from> to <to>, on the short way around
+    static std::array<double, 4> Relative(const ovrQuatf& from, const ovrQuatf& to)
+    {
+        // conj(from) * to
+        const double x = from.w * to.x - from.x * to.w - from.y * to.z + from.z * to.y;
+        const double y = from.w * to.y + from.x * to.z - from.y * to.w - from.z * to.x;
+        const double z = from.w * to.z - from.x * to.y + from.y * to.x - from.z * to.w;
+        const double w = from.w * to.w + from.x * to.x + from.y * to.y + from.z * to.z;
+        return w < 0.0 ? std::array{-x, -y, -z, -w} : std::array{x, y, z, w};
+    }
+
+    static float Length(const ovrVector3f& v)
+    {
+        return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    }
+
+    static size_t Bucket(const double intervalMs)
+    {
+        return (std::min)(static_cast<size_t>((std::max)(intervalMs, 0.0) / BucketMs), Buckets - 1);
+    }
+
+    // Everything Reset() throws away
+    struct State
+    {
+        std::array<Entry, Window> entries{};
+        size_t head = 0, count = 0, sincePublish = 0;
+
+        bool hasPrevious = false;
+        ovrPoseStatef previous{};
+        double previousTime = 0.0;
+
+        Welford3 restDelta, restTurn, velocity;
+        Welford distance, angle, interval;
+        std::array<uint32_t, Buckets> histogram{};
+    } state;
+
+    AtomicSnapshot<Stats> snapshot;
+};
@@ -0,0 +1,148 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+
+// Single-producer, multi-consumer ring of per-frame joint samples
+// Publishing is one seqlocked store no matter how many readers there are,
+// readers keep their own cursors and never hold the producer back
+template <typename T, size_t N>
+class PoseBus
+{
+public:
+    static constexpr size_t RingSize = 128; // Samples a reader may fall behind by
+
+    struct Sample
+    {
+        uint64_t sequence = 0;
+        double timestamp = 0.0; // Host seconds the frame is for
+        std::array<uint64_t, N> changedAt{}; // Sequence each joint last changed in
+        std::array<T, N> joints{};
+    };
+
+    // Producer side: append this frame, <changed> has a bit per joint that moved
+    void Publish(const std::array<T, N>& joints, const uint32_t changed, const double timestamp)
+    {
+        const auto sequence = written.load(std::memory_order_relaxed);
+        for (size_t j = 0; j < N; j++)
+            if (changed & 1u << j) changedAt[j] = sequence;
+
+        ring[sequence % RingSize].Store({
+            .sequence = sequence, .timestamp = timestamp, .changedAt = changedAt, .joints = joints
+        });
+
+        written.store(sequence + 1, std::memory_order_release);
+    }
+
+    // Reader side: copy sample <sequence> out, false if it's not (or no longer) there
+    bool Read(const uint64_t sequence, Sample& out) const
+    {
+        if (sequence >= written.load(std::memory_order_acquire)) return false;
+
+        out = ring[sequence % RingSize].Load();
+        return out.sequence == sequence; // Lapped if not
+    }
+
+    // Sequence the next sample will get
+    [[nodiscard]] uint64_t Published() const
+    {
+        return written.load(std::memory_order_acquire);
+    }
+
+    void Attach() { readers.fetch_add(1, std::memory_order_relaxed); }
+    void Detach() { readers.fetch_sub(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] uint32_t Readers() const
+    {
+        return readers.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<uint64_t, N> changedAt{}; // Producer only
+    std::array<AtomicSnapshot<Sample>, RingSize> ring;
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint32_t> readers{0};
+};
+
+// One reader's view of a PoseBus: its own cursor, rate and joint mask
+template <typename T, size_t N>
+class PoseCursor
+{
+public:
+    using Bus = PoseBus<T, N>;
+    using Sample = typename Bus::Sample;
+
+    // Start at the next published sample, <rateHz> 0 or less takes every one
+    PoseCursor(std::shared_ptr<Bus> source, const double rateHz, const uint32_t jointMask) :
+        bus(std::move(source)), interval(rateHz > 0.0 ? 1.0 / rateHz : 0.0), mask(jointMask)
+    {
+        cursor = bus->Published();
+        bus->Attach();
+    }
+
+    ~PoseCursor()
+    {
+        bus->Detach();
+    }
+
+    PoseCursor(const PoseCursor&) = delete;
+    PoseCursor& operator=(const PoseCursor&) = delete;
+
+    // Take the next sample that's due, in order, false if there's none yet
+    // <changed> gets the masked joints that moved since the last delivery
+    bool Next(Sample& out, uint32_t& changed)
+    {
+        while (true)
+        {
+            const auto head = bus->Published();
+            if (cursor >= head) return false;
+
+            // Fell too far behind, skip to the oldest sample we can still get
+            if (head - cursor > Bus::RingSize - 1)
+            {
+                const auto oldest = head - (Bus::RingSize - 1);
+                dropped += oldest - cursor;
+                cursor = oldest;
+            }
+
+            if (!bus->Read(cursor, out)) continue; // Lapped while reading, try again
+            cursor++;
+
+            // Not due yet at our rate, let it pass
+            // Measured against a schedule rather than the last delivery, so the
+            // rate doesn't round down to a divisor of the host rate
+            if (delivered && out.timestamp < nextDue - interval * 0.25) // Frame timing jitters
+            {
+                decimated++;
+                continue;
+            }
+
+            changed = 0;
+            for (size_t j = 0; j < N; j++)
+                if (mask & 1u << j && (!delivered || out.changedAt[j] > lastSequence)) changed |= 1u << j;
+
+            // One interval on, or from here if we've fallen more than one behind
+            nextDue = !delivered || out.timestamp - nextDue > interval ? out.timestamp + interval : nextDue + interval;
+            lastSequence = out.sequence;
+            delivered++;
+            return true;
+        }
+    }
+
+    [[nodiscard]] double RateHz() const { return interval > 0.0 ? 1.0 / interval : 0.0; }
+    [[nodiscard]] uint32_t JointMask() const { return mask; }
+    [[nodiscard]] uint64_t Delivered() const { return delivered; }
+    [[nodiscard]] uint64_t Dropped() const { return dropped; }
+    [[nodiscard]] uint64_t Decimated() const { return decimated; }
+
+private:
+    std::shared_ptr<Bus> bus;
+    double interval;
+    uint32_t mask;
+
+    uint64_t cursor = 0;
+    uint64_t lastSequence = 0;
+    double nextDue = 0.0; // When the next delivery is due
+
+    uint64_t delivered = 0, dropped = 0, decimated = 0;
+};
@@ -0,0 +1,363 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+#include "ThreadLauncher.h"
+#include <OVR_CAPI.h>
+
+// Samples the tracking state on its own high-rate timer into a ring of frames,
+// the host then gets a decimated estimate for its own timestamp
+class PoseOversampler
+{
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr size_t JointCount = 3; // Both hands, then the first tracked object
+    static constexpr size_t RingSize = 512;
+
+    enum class Mode
+    {
+        Average, // Anti-aliasing box average over the window
+        LinearFit // Least-squares fit evaluated at the target time, no lag
+    };
+
+    struct Frame
+    {
+        uint64_t index = 0;
+        double time = 0.0; // OVR seconds the poses were predicted for
+        std::array<ovrPoseStatef, JointCount> poses{};
+        std::array<bool, JointCount> tracked{};
+    };
+
+    PoseOversampler() = default;
+    PoseOversampler(const PoseOversampler&) = delete;
+    PoseOversampler& operator=(const PoseOversampler&) = delete;
+
+    ~PoseOversampler()
+    {
+        Stop();
+    }
+
+    // Start sampling <session> at <rateHz>, restarts if already running
+    void Start(const ovrSession session, const uint32_t objects, const int32_t rateHz)
+    {
+        Stop();
+
+        sampledSession = session;
+        objectCount = objects;
+        period = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(1.0 / std::clamp(rateHz, 100, 2000)));
+
+        stopRequested = false;
+        running.store(true, std::memory_order_release);
+        worker = ThreadLauncher::Launch("Pose sampler", ThreadLauncher::Role::Sampler, [this] { Run(); });
+    }
+
+    void Stop()
+    {
+        if (!running.exchange(false, std::memory_order_acq_rel)) return;
+        stopRequested = true;
+        if (worker.joinable()) worker.join();
+    }
+
+    [[nodiscard]] bool IsRunning() const
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    // Stop sampling while the host is idle, ticking only often enough to notice it's back
+    // Decimate() finds nothing recent meanwhile, so the host samples directly
+    void SetIdle(const bool idle)
+    {
+        paused.store(idle, std::memory_order_relaxed);
+    }
+
+    // Extra prediction added to every sample, picked up on the next tick
+    void SetPrediction(const double seconds)
+    {
+        prediction.store(seconds, std::memory_order_relaxed);
+    }
+
+    // Build one estimate per joint from the samples in (target - window, target]
+    // Returns false if there's nothing in the window to go on
+    bool Decimate(const double target, const double window, const Mode mode,
+                  std::array<ovrPoseStatef, JointCount>& poses, std::array<bool, JointCount>& tracked)
+    {
+        std::array<Accumulator, JointCount> sums{};
+        const auto head = written.load(std::memory_order_acquire);
+
+        Frame frame;
+        Frame latest;
+        size_t count = 0;
+
+        for (uint64_t i = head; i > 0 && head - i < RingSize / 2; i--)
+        {
+            frame = ring[(i - 1) % RingSize].Load();
+            if (frame.index != i - 1) break; // Overwritten in the meantime
+            if (frame.time <= target - window) break;
+            if (frame.time > target) continue; // Predicted past the target
+
+            if (count == 0) latest = frame;
+            for (size_t j = 0; j < JointCount; j++)
+                if (frame.tracked[j] == latest.tracked[j])
+                    sums[j].Add(frame.poses[j], frame.time - target, latest.poses[j].ThePose.Orientation);
+            count++;
+        }
+
+        if (count == 0) return false;
+        samplesPerUpdate.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+
+        double residual = 0.0;
+        for (size_t j = 0; j < JointCount; j++)
+        {
+            poses[j] = latest.poses[j];
+            tracked[j] = latest.tracked[j];
+            residual = (std::max)(residual, sums[j].Resolve(poses[j], mode, target));
+        }
+
+        residualRms.store(residual, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Untracked objects come back with an all-zero orientation, any real one has a non-zero component
+    static bool HasPose(const ovrPoseStatef& pose)
+    {
+        const auto& o = pose.ThePose.Orientation;
+        return o.x != 0.f || o.y != 0.f || o.z != 0.f || o.w != 0.f;
+    }
+
+    struct Stats
+    {
+        double rateHz = 0.0; // Achieved sampling rate
+        double cpuPercent = 0.0; // Sampler thread CPU time over wall time
+        double intervalJitterMs = 0.0; // Standard deviation of the tick interval
+        double maxIntervalMs = 0.0; // Longest tick interval seen
+        uint32_t samplesPerUpdate = 0; // Samples folded into the last estimate
+        double residualMm = 0.0; // RMS position noise removed by the last estimate
+    };
+
+    [[nodiscard]] Stats CurrentStats() const
+    {
+        auto stats = timing.Load();
+        stats.samplesPerUpdate = samplesPerUpdate.load(std::memory_order_relaxed);
+        stats.residualMm = residualRms.load(std::memory_order_relaxed) * 1000.0;
+        return stats;
+    }
+
+private:
+    // Running sums for one joint, times are relative to the target
+    struct Accumulator
+    {
+        double n = 0.0, t = 0.0, tt = 0.0;
+        std::array<double, 3> x{}, tx{}, xx{}, velocity{};
+        std::array<double, 4> orientation{};
+
+        void Add(const ovrPoseStatef& pose, const double time, const ovrQuatf& reference)
+        {
+            const double position[3] = {pose.ThePose.Position.x, pose.ThePose.Position.y, pose.ThePose.Position.z};
+            const double linear[3] = {pose.LinearVelocity.x, pose.LinearVelocity.y, pose.LinearVelocity.z};
+
+            n += 1.0;
+            t += time;
+            tt += time * time;
+
+            for (size_t a = 0; a < 3; a++)
+            {
+                x[a] += position[a];
+                tx[a] += time * position[a];
+                xx[a] += position[a] * position[a];
+                velocity[a] += linear[a];
+            }
+
+            // Keep every quaternion in the same hemisphere as the reference before summing
+            const auto& q = pose.ThePose.Orientation;
+            const double sign = q.x * reference.x + q.y * reference.y +
+                                q.z * reference.z + q.w * reference.w < 0.0 ? -1.0 : 1.0;
+            orientation[0] += sign * q.x;
+            orientation[1] += sign * q.y;
+            orientation[2] += sign * q.z;
+            orientation[3] += sign * q.w;
+        }
+
+        // Write the estimate into <pose>, returns the RMS position residual [m]
+        double Resolve(ovrPoseStatef& pose, const Mode mode, const double target) const
+        {
+            if (n < 1.0) return 0.0;
+
+            float* position[3] = {&pose.ThePose.Position.x, &pose.ThePose.Position.y, &pose.ThePose.Position.z};
+            float* linear[3] = {&pose.LinearVelocity.x, &pose.LinearVelocity.y, &pose.LinearVelocity.z};
+            const double denominator = n * tt - t * t;
+            const bool fitted = mode == Mode::LinearFit && n >= 3.0 && denominator > 1e-12;
+            double residual = 0.0;
+
+            for (size_t a = 0; a < 3; a++)
+            {
+                double intercept = x[a] / n, slope = 0.0;
+                if (fitted)
+                {
+                    slope = (n * tx[a] - t * x[a]) / denominator;
+                    intercept = (x[a] - slope * t) / n;
+                }
+
+                // Sum of squared residuals, expanded so we only need the running sums
+                residual += xx[a] - 2.0 * intercept * x[a] - 2.0 * slope * tx[a] +
+                    n * intercept * intercept + 2.0 * intercept * slope * t + slope * slope * tt;
+
+                *position[a] = static_cast<float>(intercept); // The fit evaluated at the target
+                *linear[a] = static_cast<float>(velocity[a] / n);
+            }
+
+            // A fit lands on the target, an average on the mean sample time
+            pose.TimeInSeconds = fitted ? target : target + t / n;
+
+            if (mode == Mode::Average)
+            {
+                const double length = std::sqrt(orientation[0] * orientation[0] + orientation[1] * orientation[1] +
+                    orientation[2] * orientation[2] + orientation[3] * orientation[3]);
+
+                if (length > 1e-9)
+                    pose.ThePose.Orientation = {
+                        static_cast<float>(orientation[0] / length), static_cast<float>(orientation[1] / length),
+                        static_cast<float>(orientation[2] / length), static_cast<float>(orientation[3] / length)
+                    };
+            }
+
+            return std::sqrt((std::max)(residual, 0.0) / n);
+        }
+    };
+
+    void Run()
+    {
+        const HANDLE timer = CreateWaitableTimerEx(
+            nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+        auto next = clock::now();
+        auto last = next;
+        auto windowStart = next;
+        ULONGLONG cpuStart = ThreadCpuTime();
+
+        double mean = 0.0, m2 = 0.0, worst = 0.0;
+        uint64_t ticks = 0, windowTicks = 0;
+
+        while (!stopRequested)
+        {
+            const bool idle = paused.load(std::memory_order_relaxed);
+            if (!idle) Sample();
+
+            // Sleep until the next tick, on the high resolution timer if we have one
+            next += idle ? idlePeriod : period;
+            if (const auto remaining = next - clock::now(); remaining > clock::duration::zero())
+            {
+                LARGE_INTEGER due;
+                due.QuadPart = -std::chrono::duration_cast<std::chrono::duration<LONGLONG, std::ratio<1, 10000000>>>(
+                    remaining).count();
+
+                if (timer && SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE))
+                {
+                    WaitForSingleObject(timer, INFINITE);
+                    ThreadLauncher::MarkWake(next);
+                }
+                else ThreadLauncher::SleepUntil(next);
+            }
+            else next = clock::now(); // We're late, don't try to catch up
+
+            const auto now = clock::now();
+            if (idle)
+            {
+                // Keep the pause out of the tick stats, start a fresh window once we're back
+                last = windowStart = now;
+                cpuStart = ThreadCpuTime();
+                windowTicks = 0;
+                continue;
+            }
+
+            // Welford over the tick intervals
+            const double interval = std::chrono::duration<double, std::milli>(now - last).count();
+            last = now;
+
+            ticks++;
+            windowTicks++;
+            const double delta = interval - mean;
+            mean += delta / static_cast<double>(ticks);
+            m2 += delta * (interval - mean);
+            worst = (std::max)(worst, interval);
+
+            // Publish timing stats about once a second
+            if (now - windowStart >= std::chrono::seconds(1))
+            {
+                const double wall = std::chrono::duration<double>(now - windowStart).count();
+                const ULONGLONG cpu = ThreadCpuTime();
+
+                timing.Store({
+                    .rateHz = static_cast<double>(windowTicks) / wall,
+                    .cpuPercent = static_cast<double>(cpu - cpuStart) / 1e7 / wall * 100.0,
+                    .intervalJitterMs = ticks > 1 ? std::sqrt(m2 / static_cast<double>(ticks - 1)) : 0.0,
+                    .maxIntervalMs = worst
+                });
+
+                windowStart = now;
+                cpuStart = cpu;
+                windowTicks = 0;
+            }
+        }
+
+        if (timer) CloseHandle(timer);
+    }
+
+    // One tick: grab everything we export into a new ring frame
+    void Sample()
+    {
+        const auto index = written.load(std::memory_order_relaxed);
+        Frame frame{.index = index, .time = ovr_GetTimeInSeconds() + prediction.load(std::memory_order_relaxed)};
+
+        const auto state = ovr_GetTrackingState(sampledSession, frame.time, ovrTrue);
+        for (int i = 0; i <= 1; i++)
+        {
+            constexpr unsigned int tracked_flags = ovrStatus_OrientationTracked | ovrStatus_PositionTracked;
+            frame.poses[i] = state.HandPoses[i];
+            frame.tracked[i] = (state.HandStatusFlags[i] & tracked_flags) == tracked_flags;
+        }
+
+        for (uint32_t i = 0; i < objectCount; i++)
+        {
+            auto deviceType = static_cast<ovrTrackedDeviceType>(ovrTrackedDevice_Object0 + i);
+            ovrPoseStatef pose{};
+
+            if (OVR_SUCCESS(ovr_GetDevicePoses(sampledSession, &deviceType, 1, frame.time, &pose)) && HasPose(pose))
+            {
+                frame.poses[2] = pose;
+                frame.tracked[2] = true;
+            }
+        }
+
+        ring[index % RingSize].Store(frame);
+        written.store(index + 1, std::memory_order_release);
+    }
+
+    // Kernel + user time of the calling thread, in 100ns units
+    static ULONGLONG ThreadCpuTime()
+    {
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0;
+
+        return (static_cast<ULONGLONG>(kernel.dwHighDateTime) << 32 | kernel.dwLowDateTime) +
+            (static_cast<ULONGLONG>(user.dwHighDateTime) << 32 | user.dwLowDateTime);
+    }
+
+    ovrSession sampledSession = nullptr;
+    uint32_t objectCount = 0;
+    clock::duration period = std::chrono::milliseconds(1);
+    clock::duration idlePeriod = std::chrono::milliseconds(100); // Tick while paused
+
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> paused{false};
+    std::atomic<double> prediction{0.0};
+
+    std::array<AtomicSnapshot<Frame>, RingSize> ring;
+    std::atomic<uint64_t> written{0};
+
+    AtomicSnapshot<Stats> timing;
+    std::atomic<uint32_t> samplesPerUpdate{0};
+    std::atomic<double> residualRms{0.0};
+};
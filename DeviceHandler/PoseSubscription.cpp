@@ -0,0 +1,106 @@
+#include "pch.h"
+#include "PoseSubscription.h"
+#if __has_include("PoseSubscription.g.cpp")
+#include "PoseSubscription.g.cpp"
+#endif
+
+namespace winrt::DeviceHandler::implementation
+{
+    PoseSubscription::PoseSubscription(std::shared_ptr<JointBus> bus, std::vector<hstring> names,
+                                       const double rateHz, const uint32_t jointMask) :
+        cursor(std::make_unique<PoseCursor<JointSample, 3>>(std::move(bus), rateHz, jointMask)),
+        names(std::move(names)), rateHz(rateHz), jointMask(jointMask)
+    {
+    }
+
+    double PoseSubscription::RateHz() const
+    {
+        return rateHz;
+    }
+
+    uint32_t PoseSubscription::JointMask() const
+    {
+        return jointMask;
+    }
+
+    com_array<Joint> PoseSubscription::Poll()
+    {
+        std::lock_guard lock(cursorMutex);
+        if (!cursor) return {};
+
+        JointBus::Sample sample;
+        if (!cursor->Next(sample, changedJoints)) return {};
+
+        // Only the joints this subscriber asked for, in joint order
+        std::vector<Joint> joints;
+        for (size_t i = 0; i < sample.joints.size() && i < names.size(); i++)
+            if (jointMask & 1u << i) joints.push_back(FromSample(sample.joints[i], names[i]));
+
+        return com_array<Joint>{joints};
+    }
+
+    uint32_t PoseSubscription::ChangedJoints() const
+    {
+        std::lock_guard lock(cursorMutex);
+        return changedJoints;
+    }
+
+    uint64_t PoseSubscription::Delivered() const
+    {
+        std::lock_guard lock(cursorMutex);
+        return cursor ? cursor->Delivered() : 0;
+    }
+
+    uint64_t PoseSubscription::Dropped() const
+    {
+        std::lock_guard lock(cursorMutex);
+        return cursor ? cursor->Dropped() : 0;
+    }
+
+    uint64_t PoseSubscription::Decimated() const
+    {
+        std::lock_guard lock(cursorMutex);
+        return cursor ? cursor->Decimated() : 0;
+    }
+
+    void PoseSubscription::Close()
+    {
+        std::lock_guard lock(cursorMutex);
+        cursor.reset(); // Detaches from the bus
+    }
+
+    JointSample PoseSubscription::ToSample(const Joint& joint)
+    {
+        return {
+            .Position = joint.Position,
+            .Orientation = joint.Orientation,
+            .Velocity = joint.Velocity,
+            .Acceleration = joint.Acceleration,
+            .AngularVelocity = joint.AngularVelocity,
+            .AngularAcceleration = joint.AngularAcceleration,
+            .TrackingState = joint.TrackingState,
+            .Confidence = joint.Confidence,
+            .BoundaryDistance = joint.BoundaryDistance,
+            .BoundaryPoint = joint.BoundaryPoint,
+            .Timestamp = joint.Timestamp
+        };
+    }
+
+    Joint PoseSubscription::FromSample(const JointSample& sample, const hstring& name)
+    {
+        return {
+            .Name = name,
+            .Position = sample.Position,
+            .Orientation = sample.Orientation,
+            .Velocity = sample.Velocity,
+            .Acceleration = sample.Acceleration,
+            .AngularVelocity = sample.AngularVelocity,
+            .AngularAcceleration = sample.AngularAcceleration,
+            .TrackingState = sample.TrackingState,
+            .Confidence = sample.Confidence,
+            .BoundaryDistance = sample.BoundaryDistance,
+            .BoundaryPoint = sample.BoundaryPoint,
+            .Timestamp = sample.Timestamp
+        };
+    }
+}
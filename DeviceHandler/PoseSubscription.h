@@ -0,0 +1,58 @@
+#pragma once
+#include "PoseSubscription.g.h"
+#include "PoseBus.h"
+
+namespace winrt::DeviceHandler::implementation
+{
+    // Joint minus its name, so it can travel through the bus
+    struct JointSample
+    {
+        Vector Position;
+        Quaternion Orientation;
+
+        Vector Velocity;
+        Vector Acceleration;
+        Vector AngularVelocity;
+        Vector AngularAcceleration;
+
+        JointTrackingState TrackingState;
+        float Confidence;
+
+        float BoundaryDistance;
+        Vector BoundaryPoint;
+
+        double Timestamp;
+    };
+
+    using JointBus = PoseBus<JointSample, 3>;
+
+    struct PoseSubscription : PoseSubscriptionT<PoseSubscription>
+    {
+        PoseSubscription(std::shared_ptr<JointBus> bus, std::vector<hstring> names,
+                         double rateHz, uint32_t jointMask);
+
+        [[nodiscard]] double RateHz() const;
+        [[nodiscard]] uint32_t JointMask() const;
+
+        com_array<Joint> Poll();
+        [[nodiscard]] uint32_t ChangedJoints() const;
+
+        [[nodiscard]] uint64_t Delivered() const;
+        [[nodiscard]] uint64_t Dropped() const;
+        [[nodiscard]] uint64_t Decimated() const;
+
+        void Close();
+
+        static JointSample ToSample(const Joint& joint);
+        static Joint FromSample(const JointSample& sample, const hstring& name);
+
+    private:
+        mutable std::mutex cursorMutex; // Polled from one thread normally, Close() may race it
+        std::unique_ptr<PoseCursor<JointSample, 3>> cursor;
+        std::vector<hstring> names;
+
+        double rateHz;
+        uint32_t jointMask;
+        uint32_t changedJoints = 0;
+    };
+}
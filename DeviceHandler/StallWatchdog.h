@@ -0,0 +1,129 @@
+#pragma once
+#include <pch.h>
+
+#include "AtomicSnapshot.h"
+
+// Times blocking OVR calls against deadlines, counts overruns
+// and backs every call off while the runtime is misbehaving
+class StallWatchdog
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    enum class Call
+    {
+        SubmitFrame,
+        TrackingState,
+        DevicePoses,
+        BoundaryGeometry,
+        PerfStats,
+        Count
+    };
+
+    static constexpr size_t CallCount = static_cast<size_t>(Call::Count);
+
+    std::array<clock::duration, CallCount> deadlines{
+        std::chrono::milliseconds(50), // SubmitFrame, includes vsync pacing
+        std::chrono::milliseconds(10), // TrackingState
+        std::chrono::milliseconds(10), // DevicePoses
+        std::chrono::milliseconds(10), // BoundaryGeometry
+        std::chrono::milliseconds(10) // PerfStats
+    };
+
+    clock::duration minBackoff = std::chrono::milliseconds(100); // Submission, doubles per overrun
+    clock::duration maxBackoff = std::chrono::seconds(5); // Any call
+
+    struct Stats
+    {
+        std::array<uint32_t, CallCount> stalls{}; // Deadline overruns
+        std::array<double, CallCount> worstMs{}; // Longest call seen
+        uint64_t staleFrames = 0; // Frames that had to export an older sample
+        clock::time_point exported{}; // When the last exported sample was taken
+    };
+
+    // Run <function> and time it, returns false if it has overrun its deadline
+    // A call may be timed from one thread only, that thread owns its backoff
+    template <typename F>
+    bool Time(const Call call, F&& function)
+    {
+        const auto start = clock::now();
+        function();
+        const auto end = clock::now();
+
+        const auto index = static_cast<size_t>(call);
+        const auto elapsed = end - start;
+        const bool inTime = elapsed <= deadlines[index];
+
+        published.Modify([&](Stats& stats)
+        {
+            stats.worstMs[index] = (std::max)(stats.worstMs[index], Milliseconds(elapsed));
+            if (!inTime) stats.stalls[index]++;
+        });
+
+        auto& backoff = backoffs[index];
+        if (inTime)
+        {
+            backoff = {}; // Recovered
+            return true;
+        }
+
+        // Submission waits exponentially longer, pose queries give the runtime
+        // as much idle time as the slow call took, so a merely slow runtime
+        // still gets sampled at about half its pace rather than not at all
+        if (call == Call::SubmitFrame)
+            backoff = backoff == clock::duration{} ? minBackoff : (std::min)(backoff * 2, maxBackoff);
+        else backoff = (std::min)(elapsed, maxBackoff);
+
+        backoffUntil[index].store(end + backoff, std::memory_order_release);
+        return false;
+    }
+
+    // Check if <call> may run right now (callable from any thread)
+    [[nodiscard]] bool ShouldRun(const Call call, const clock::time_point now) const
+    {
+        return now >= backoffUntil[static_cast<size_t>(call)].load(std::memory_order_acquire);
+    }
+
+    // Mark the sample a frame has exported, taken at <sampled>
+    // <fresh> is false if the frame had to fall back on an older one
+    void MarkExported(const clock::time_point sampled, const bool fresh)
+    {
+        published.Modify([&](Stats& stats)
+        {
+            stats.exported = sampled;
+            if (!fresh) stats.staleFrames++;
+        });
+    }
+
+    // Latest figures, safe from any thread
+    [[nodiscard]] Stats CurrentStats() const
+    {
+        return published.Load();
+    }
+
+    // How old the exported sample is at <now>
+    [[nodiscard]] static double StalenessMs(const Stats& stats, const clock::time_point now)
+    {
+        if (stats.exported == clock::time_point{}) return 0.0;
+        return Milliseconds(now - stats.exported);
+    }
+
+    // Check if any call is being held back right now
+    [[nodiscard]] bool IsBackingOff(const clock::time_point now) const
+    {
+        for (size_t i = 0; i < CallCount; i++)
+            if (!ShouldRun(static_cast<Call>(i), now)) return true;
+        return false;
+    }
+
+    static double Milliseconds(const clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+private:
+    std::array<clock::duration, CallCount> backoffs{}; // Owned by each call's timing thread
+    std::array<std::atomic<clock::time_point>, CallCount> backoffUntil{};
+
+    AtomicSnapshot<Stats> published;
+};
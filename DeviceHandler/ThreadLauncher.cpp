@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "ThreadLauncher.h"
+#include "AtomicSnapshot.h"
+
+#include <avrt.h>
+#pragma comment(lib, "avrt.lib")
+
+namespace
+{
+    using namespace ThreadLauncher;
+
+    struct Slot
+    {
+        bool claimed = false; // Under claimMutex
+        AtomicSnapshot<WakeStats> stats;
+    };
+
+    std::mutex claimMutex;
+    std::array<Slot, MaxThreads> slots;
+    std::array<AtomicSnapshot<Policy>, 2> policies; // By role
+
+    // Per-thread bookkeeping, only ever touched by its own thread
+    struct LocalState
+    {
+        Slot* slot = nullptr;
+        Role role = Role::Worker;
+        uint64_t policyVersion = (std::numeric_limits<uint64_t>::max)();
+        WakeStats stats{};
+        double m2 = 0.0; // Welford sum of squared deviations
+        HANDLE mmcss = nullptr;
+    };
+
+    thread_local LocalState local;
+
+    // Apply <policy> to the calling thread, returns false if any part was refused
+    bool ApplyPolicy(const Policy& policy)
+    {
+        bool applied = true;
+
+        // MMCSS first, it decides the priority while it's on
+        if (policy.realtime && !local.mmcss)
+        {
+            DWORD task = 0;
+            local.mmcss = AvSetMmThreadCharacteristicsW(L"Pro Audio", &task);
+            applied &= local.mmcss && AvSetMmThreadPriority(local.mmcss, AVRT_PRIORITY_HIGH);
+        }
+        else if (!policy.realtime && local.mmcss)
+        {
+            AvRevertMmThreadCharacteristics(local.mmcss);
+            local.mmcss = nullptr;
+        }
+
+        if (!policy.realtime)
+        {
+            constexpr int priorities[] = {
+                THREAD_PRIORITY_BELOW_NORMAL, THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_ABOVE_NORMAL,
+                THREAD_PRIORITY_HIGHEST, THREAD_PRIORITY_TIME_CRITICAL
+            };
+
+            // Validated by whoever configured it, but never index past the table
+            const auto index = std::clamp(static_cast<int>(policy.priority), 0, static_cast<int>(std::size(priorities)) - 1);
+            applied &= SetThreadPriority(GetCurrentThread(), priorities[index]) != 0;
+        }
+
+        // Never ask for cores outside of the process mask
+        DWORD_PTR process = 0, system = 0;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &process, &system))
+        {
+            const auto mask = policy.affinity ? static_cast<DWORD_PTR>(policy.affinity) & process : process;
+            applied &= mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+        }
+        else applied = false;
+
+        return applied;
+    }
+
+    // Pick the role's policy up if it changed since we last looked
+    void RefreshPolicy()
+    {
+        const auto& snapshot = policies[static_cast<size_t>(local.role)];
+        if (snapshot.Version() == local.policyVersion) return;
+
+        local.stats.applied = ApplyPolicy(snapshot.Load(&local.policyVersion));
+        if (local.slot) local.slot->stats.Store(local.stats);
+    }
+
+    void NameThread(const char* name)
+    {
+        wchar_t wide[64] = {};
+        for (size_t i = 0; i + 1 < std::size(wide) && name[i]; i++)
+            wide[i] = static_cast<wchar_t>(name[i]);
+
+        SetThreadDescription(GetCurrentThread(), wide);
+    }
+}
+
+namespace ThreadLauncher
+{
+    void Configure(const Role role, const Policy& policy)
+    {
+        policies[static_cast<size_t>(role)].Store(policy);
+    }
+
+    Policy Current(const Role role)
+    {
+        return policies[static_cast<size_t>(role)].Load();
+    }
+
+    size_t Stats(WakeStats* out, const size_t max)
+    {
+        std::lock_guard lock(claimMutex);
+
+        size_t written = 0;
+        for (size_t i = 0; i < slots.size() && written < max; i++)
+            if (slots[i].claimed) out[written++] = slots[i].stats.Load();
+
+        return written;
+    }
+
+    void MarkWake(const clock::time_point deadline)
+    {
+        const double late = (std::max)(
+            std::chrono::duration<double, std::micro>(clock::now() - deadline).count(), 0.0);
+
+        auto& stats = local.stats;
+        stats.wakeups++;
+        const double delta = late - stats.meanUs;
+        stats.meanUs += delta / static_cast<double>(stats.wakeups);
+        local.m2 += delta * (late - stats.meanUs);
+        stats.jitterUs = stats.wakeups > 1 ? std::sqrt(local.m2 / static_cast<double>(stats.wakeups - 1)) : 0.0;
+        stats.maxUs = (std::max)(stats.maxUs, late);
+
+        RefreshPolicy();
+        if (local.slot) local.slot->stats.Store(stats);
+    }
+
+    void SleepUntil(const clock::time_point deadline)
+    {
+        std::this_thread::sleep_until(deadline);
+        MarkWake(deadline);
+    }
+
+    Registration::Registration(const char* name, const Role role)
+    {
+        local = {};
+        local.role = role;
+        local.stats = {.name = name, .role = role, .running = true};
+
+        {
+            // Reuse our old slot if we've been here before, so the list stays short
+            std::lock_guard lock(claimMutex);
+            Slot* free = nullptr;
+
+            for (auto& slot : slots)
+            {
+                if (!slot.claimed)
+                {
+                    if (!free) free = &slot;
+                    continue;
+                }
+
+                const auto previous = slot.stats.Load();
+                if (!previous.running && std::strcmp(previous.name, name) == 0)
+                {
+                    local.slot = &slot;
+                    break;
+                }
+            }
+
+            if (!local.slot && free)
+            {
+                free->claimed = true;
+                local.slot = free;
+            }
+
+            if (local.slot) local.slot->stats.Store(local.stats);
+        }
+
+        NameThread(name);
+        RefreshPolicy();
+    }
+
+    Registration::~Registration()
+    {
+        if (local.mmcss) AvRevertMmThreadCharacteristics(local.mmcss);
+        local.stats.running = false;
+        if (local.slot) local.slot->stats.Store(local.stats);
+        local.slot = nullptr;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <pch.h>
+
+// Starts native worker threads under a configurable scheduling policy
+// (priority, core affinity, optional real-time class) and keeps track
+// of how late each of them wakes up relative to its deadline
+namespace ThreadLauncher
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr size_t MaxThreads = 16; // Threads we'll keep stats for
+
+    enum class Role
+    {
+        Sampler, // Latency-critical, runs on a tight timer
+        Worker // Housekeeping, keep-alive and trace flushing
+    };
+
+    enum class Priority
+    {
+        Low,
+        Normal,
+        AboveNormal,
+        High,
+        Critical
+    };
+
+    struct Policy
+    {
+        Priority priority = Priority::Normal;
+        uint64_t affinity = 0; // Allowed cores, 0 for any
+        bool realtime = false; // MMCSS "Pro Audio" class
+    };
+
+    struct WakeStats
+    {
+        const char* name = nullptr;
+        Role role = Role::Worker;
+        bool running = false;
+        bool applied = false; // The last policy went through in full
+        uint64_t wakeups = 0;
+        double meanUs = 0.0; // Mean lateness past the deadline
+        double jitterUs = 0.0; // Standard deviation of the lateness
+        double maxUs = 0.0; // Worst lateness seen
+    };
+
+    // Set the policy for <role>, running threads pick it up on their next wake
+    void Configure(Role role, const Policy& policy);
+
+    // Current policy for <role>
+    Policy Current(Role role);
+
+    // Copy out up to <max> per-thread stats, returns how many were written
+    size_t Stats(WakeStats* out, size_t max);
+
+    // Record a wake-up that was due at <deadline>, calling thread only
+    // Also re-applies the role's policy if it changed since the last wake
+    void MarkWake(clock::time_point deadline);
+
+    // Sleep until <deadline>, then record how late we woke
+    void SleepUntil(clock::time_point deadline);
+
+    // Registers the calling thread under <name> while alive
+    class Registration
+    {
+    public:
+        Registration(const char* name, Role role);
+        ~Registration();
+
+        Registration(const Registration&) = delete;
+        Registration& operator=(const Registration&) = delete;
+    };
+
+    // Start <body> on a new thread, named and scheduled for <role>
+    // <name> is kept around for the stats, so pass a string literal
+    template <typename F>
+    std::thread Launch(const char* name, const Role role, F&& body)
+    {
+        return std::thread([name, role, body = std::forward<F>(body)]() mutable
+        {
+            Registration registration(name, role);
+            body();
+        });
+    }
+}
@@ -0,0 +1,257 @@
+#pragma once
+#include <pch.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "ThreadLauncher.h"
+
+// Opt-in timeline tracer: begin/end events go into per-thread lock-free rings,
+// a background thread drains them into a Chrome/Perfetto JSON trace file
+class TraceRecorder
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    TraceRecorder() = default;
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    ~TraceRecorder()
+    {
+        Stop();
+    }
+
+    // Start writing a new trace to <path>, returns false if it can't be opened
+    bool Start(const std::filesystem::path& path)
+    {
+        Stop(); // Close the previous trace, if any
+        std::lock_guard lock(controlMutex);
+
+        file.open(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        firstEvent = true;
+        namedThreads.clear();
+
+        {
+            std::lock_guard buffersLock(buffersMutex);
+            for (const auto& buffer : buffers)
+                buffer->dropped.store(0, std::memory_order_relaxed); // Count per trace
+        }
+
+        sessionStart = clock::now();
+        stopFlusher = false;
+        enabled.store(true, std::memory_order_release);
+        flusher = ThreadLauncher::Launch("Trace flusher", ThreadLauncher::Role::Worker, [this] { FlushLoop(); });
+        return true;
+    }
+
+    // Drain everything that's left and close the trace file
+    void Stop()
+    {
+        std::lock_guard lock(controlMutex);
+        if (!enabled.exchange(false, std::memory_order_acq_rel)) return;
+
+        stopFlusher = true;
+        if (flusher.joinable()) flusher.join();
+
+        Drain(); // Catch the stragglers
+        file << "]}";
+        file.close();
+    }
+
+    [[nodiscard]] bool IsEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // Events lost to full rings since the current trace was started
+    [[nodiscard]] uint64_t DroppedEvents() const
+    {
+        std::lock_guard lock(buffersMutex);
+        uint64_t dropped = 0;
+        for (const auto& buffer : buffers)
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        return dropped;
+    }
+
+    // Name the calling thread in the trace, never registers a ring by itself
+    // The name is kept and goes on the thread's ring once it records something
+    void NameThread(const char* name)
+    {
+        lease.name = name;
+        if (lease.owner == instanceId) lease.buffer->name.store(name, std::memory_order_release);
+    }
+
+    // Record an event for the calling thread, wait-free, drops if the ring's full
+    void Record(const char* name, const char phase)
+    {
+        if (!IsEnabled()) return;
+
+        auto* buffer = LocalBuffer();
+        const auto head = buffer->head.load(std::memory_order_relaxed);
+        if (head - buffer->tail.load(std::memory_order_acquire) >= RingSize)
+        {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->events[head % RingSize] = {name, clock::now(), phase};
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_t RingSize = 16384;
+
+    struct Event
+    {
+        const char* name;
+        clock::time_point time;
+        char phase;
+    };
+
+    struct ThreadBuffer
+    {
+        uint32_t id = 0; // Under buffersMutex
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> head{0}, tail{0}, dropped{0};
+        std::atomic<bool> released{false}; // Its thread has exited
+        std::array<Event, RingSize> events{};
+    };
+
+    // The calling thread's hold on its ring, handed back when the thread exits
+    // Shared, so a thread outliving the recorder never touches freed memory
+    struct Lease
+    {
+        uint64_t owner = 0;
+        std::shared_ptr<ThreadBuffer> buffer;
+        const char* name = nullptr;
+
+        ~Lease()
+        {
+            if (buffer) buffer->released.store(true, std::memory_order_release);
+        }
+    };
+
+    inline static thread_local Lease lease;
+
+    // Find or register the calling thread's ring, reusing a drained one of an exited thread
+    ThreadBuffer* LocalBuffer()
+    {
+        if (lease.owner == instanceId) return lease.buffer.get();
+        if (lease.buffer) lease.buffer->released.store(true, std::memory_order_release); // Another recorder's
+
+        std::lock_guard lock(buffersMutex);
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        for (const auto& candidate : buffers)
+            if (candidate->released.load(std::memory_order_acquire) &&
+                candidate->tail.load(std::memory_order_relaxed) == candidate->head.load(std::memory_order_relaxed))
+            {
+                buffer = candidate;
+                break;
+            }
+
+        if (!buffer) buffer = buffers.emplace_back(std::make_shared<ThreadBuffer>());
+
+        buffer->id = ++threadCount; // A fresh track in the trace, even on a reused ring
+        buffer->name.store(lease.name, std::memory_order_release);
+        buffer->released.store(false, std::memory_order_relaxed);
+
+        lease.owner = instanceId;
+        lease.buffer = buffer;
+        return buffer.get();
+    }
+
+    void FlushLoop()
+    {
+        auto next = clock::now();
+        while (!stopFlusher)
+        {
+            Drain();
+            next += std::chrono::milliseconds(100);
+            ThreadLauncher::SleepUntil(next);
+        }
+    }
+
+    // Move everything recorded so far into the file, flusher/control side only
+    void Drain()
+    {
+        std::lock_guard lock(buffersMutex);
+        for (const auto& buffer : buffers)
+        {
+            const auto* name = buffer->name.load(std::memory_order_acquire);
+            if (name && namedThreads.insert(buffer->id).second)
+                WriteEvent(std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                                       "\"args\":{{\"name\":\"{}\"}}}}", buffer->id, name));
+
+            const auto head = buffer->head.load(std::memory_order_acquire);
+            auto tail = buffer->tail.load(std::memory_order_relaxed);
+
+            for (; tail < head; tail++)
+            {
+                const auto& event = buffer->events[tail % RingSize];
+                if (event.time < sessionStart) continue; // Left over from a previous trace
+
+                WriteEvent(std::format("{{\"name\":\"{}\",\"ph\":\"{}\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}}}",
+                                       event.name, event.phase, buffer->id,
+                                       std::chrono::duration<double, std::micro>(event.time - sessionStart).count()));
+            }
+
+            buffer->tail.store(tail, std::memory_order_release);
+        }
+
+        file.flush();
+    }
+
+    void WriteEvent(const std::string& event)
+    {
+        if (!firstEvent) file << ',';
+        file << event;
+        firstEvent = false;
+    }
+
+    // Unique per recorder, so thread-local caches never outlive their owner
+    inline static std::atomic<uint64_t> instanceCounter{0};
+    const uint64_t instanceId = ++instanceCounter;
+
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> stopFlusher{false};
+    std::thread flusher;
+
+    std::mutex controlMutex;
+    mutable std::mutex buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t threadCount = 0; // Under buffersMutex
+
+    std::ofstream file;
+    std::set<uint32_t> namedThreads;
+    clock::time_point sessionStart{};
+    bool firstEvent = true;
+};
+
+// Records a begin/end pair around its lifetime
+class TraceScope
+{
+public:
+    TraceScope(TraceRecorder& recorder, const char* name) :
+        recorder(recorder), name(name)
+    {
+        recorder.Record(name, 'B');
+    }
+
+    ~TraceScope()
+    {
+        recorder.Record(name, 'E');
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceRecorder& recorder;
+    const char* name;
+};
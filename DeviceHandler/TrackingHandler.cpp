@@ -8,122 +8,160 @@ namespace winrt::DeviceHandler::implementation
     {
         // Update joints' poses here
         // Note: this is fired up every loop
+        TraceScope trace_update(tracer, "Update");
+        if (tracer.IsEnabled()) tracer.NameThread("Update");
 
         // Run the update loop
         if (initialized && statusResult == S_OK)
         {
-            if (keepAlive && !ODTKRAstop && !is_ODTKRA_started)
+            ApplyConfig(); // Refresh settings at the frame boundary
+
+            SteerKeepAlive(); // Never waits on the worker
+
+            // Read the OVR clock between two host clock reads, this keeps the two in sync
+            const auto clock_before = std::chrono::steady_clock::now();
+            const double ovr_now = ovr_GetTimeInSeconds();
+            clockSync.Observe(ovr_now, clock_before, std::chrono::steady_clock::now());
+
+            // Everything this frame is sampled for the same (predicted) time
+            const double sample_time = ovr_now + settings.extraPrediction * 0.001;
+
+            // Have the sampler thread query the runtime and give it until the deadline,
+            // if it's stalling we carry on with the newest sample it did publish
+            if (const auto requested = sampler.Request(sample_time))
             {
-                ODTKRAThread = std::thread([this] { this->keepRiftAlive(); });
-                is_ODTKRA_started = true;
+                TraceScope trace(tracer, "WaitForSample");
+                sampler.WaitFor(requested, std::chrono::steady_clock::now() +
+                                watchdog.deadlines[static_cast<size_t>(StallWatchdog::Call::TrackingState)]);
             }
-            else if (!keepAlive && is_ODTKRA_started)
+
+            const auto sample = sampler.Latest();
+            const auto now = std::chrono::steady_clock::now();
+            if (sample.sequence == 0) return; // Nothing to export yet
+
+            const bool fresh = sample.sequence != lastSampleSequence;
+            lastSampleSequence = sample.sequence;
+            watchdog.MarkExported(sample.completed, fresh);
+
+            // Check if we're allowed to do a full frame, the sample above is taken on
+            // every frame anyway, so movement wakes us up within one frame
+            const bool full_frame = governor.Evaluate(now, ProbeMotion(sample), sample.hmdMounted, settings.idleThrottle);
+            oversampler.SetIdle(governor.CurrentState() == IdleGovernor::State::Idle); // Nobody needs 1 kHz poses now
+            if (!full_frame) return; // Throttled, nothing's changed anyway
+
+            // Hand a frame to the submitter unless the runtime has been stalling on us,
+            // it's skipped if the last one hasn't returned yet
+            if (watchdog.ShouldRun(StallWatchdog::Call::SubmitFrame, now))
+                submitter.Request();
+
+            // Take the controller and object poses over from the sample
+            rawPoses = sample.poses;
+            rawTracked = sample.tracked;
+            double pose_time = sample.time;
+
+            // Replace the single sample with the decimated high-rate ones, if we can
+            const double window = std::clamp(sample_time - lastSampleTime, 0.001, 0.05);
+            lastSampleTime = sample_time;
+
+            if (oversampler.IsRunning())
+                oversampler.SetPrediction(settings.extraPrediction * 0.001);
+
+            if (oversampler.IsRunning() &&
+                oversampler.Decimate(sample_time, window, settings.decimation, rawPoses, rawTracked))
+                pose_time = sample_time;
+
+            TraceScope trace_export(tracer, "ProcessJoints");
+
+            // Grab the transform once per frame, everything's stale if it or the play area moved
+            uint64_t calibration_version = 0;
+            const auto transform = calibration.Load(&calibration_version);
+
+            // The boundary query is only due every so often, but it blocks all the same
+            bool boundary_changed = false;
+            if (watchdog.ShouldRun(StallWatchdog::Call::BoundaryGeometry, now) &&
+                !watchdog.Time(StallWatchdog::Call::BoundaryGeometry, [&, this]
+                {
+                    TraceScope trace(tracer, "GetBoundaryGeometry");
+                    boundary_changed = boundary.Refresh(guardian->mSession, now);
+                }))
+                Log(L"ovr_GetBoundaryGeometry overran its deadline, backing off boundary queries", 1);
+
+            if (boundary_changed)
             {
-                ODTKRAstop = true;
-                is_ODTKRA_started = false;
-                killODT();
-                ODTKRAThread.join();
-                ODTKRAstop = false;
+                Log(std::format(L"Play area boundary updated, {} edges", boundary.EdgeCount()), 0);
+                changes.Invalidate();
             }
 
-            guardian->Render();
+            if (calibration_version != appliedCalibration) changes.Invalidate();
+            appliedCalibration = calibration_version;
+            const bool invalidated = changes.TakeInvalidation();
 
-            const auto tracking_state = ovr_GetTrackingState(
-                guardian->mSession, ovr_GetTimeInSeconds() +
-                static_cast<float>(extraPrediction) * 0.001, ovrTrue);
+            if (noiseResetRequested.exchange(false, std::memory_order_acq_rel))
+                for (auto& monitor : noise) monitor.Reset();
 
-            // Grab controller poses
-            for (int i = 0; i <= 1; i++)
+            // Rebuild exported joints from the raw OVR-space poses, dead-reckoning
+            // through dropouts and blending back after them, where anything changed
+            uint32_t dirty = 0;
+            for (size_t i = 0; i < trackedJoints.size(); i++)
             {
-                trackedJoints.at(i).Position = {
-                    tracking_state.HandPoses[i].ThePose.Position.x,
-                    tracking_state.HandPoses[i].ThePose.Position.y,
-                    tracking_state.HandPoses[i].ThePose.Position.z
-                };
-
-                trackedJoints.at(i).Orientation = {
-                    tracking_state.HandPoses[i].ThePose.Orientation.x,
-                    tracking_state.HandPoses[i].ThePose.Orientation.y,
-                    tracking_state.HandPoses[i].ThePose.Orientation.z,
-                    tracking_state.HandPoses[i].ThePose.Orientation.w
-                };
-
-                trackedJoints.at(i).Velocity = {
-                    tracking_state.HandPoses[i].LinearVelocity.x,
-                    tracking_state.HandPoses[i].LinearVelocity.y,
-                    tracking_state.HandPoses[i].LinearVelocity.z
-                };
-
-                trackedJoints.at(i).Acceleration = {
-                    tracking_state.HandPoses[i].LinearAcceleration.x,
-                    tracking_state.HandPoses[i].LinearAcceleration.y,
-                    tracking_state.HandPoses[i].LinearAcceleration.z
-                };
-
-                trackedJoints.at(i).AngularVelocity = {
-                    tracking_state.HandPoses[i].AngularVelocity.x,
-                    tracking_state.HandPoses[i].AngularVelocity.y,
-                    tracking_state.HandPoses[i].AngularVelocity.z
-                };
-
-                trackedJoints.at(i).AngularAcceleration = {
-                    tracking_state.HandPoses[i].AngularAcceleration.x,
-                    tracking_state.HandPoses[i].AngularAcceleration.y,
-                    tracking_state.HandPoses[i].AngularAcceleration.z
-                };
+                noise[i].Add(rawPoses[i], rawTracked[i], pose_time); // Measurement noise, before filtering
+
+                const auto previous = dropouts[i].CurrentState();
+                const auto& pose = dropouts[i].Update(rawPoses[i], rawTracked[i], pose_time);
+                const auto state = dropouts[i].CurrentState();
+
+                // Stamp every joint, even unchanged ones are valid for this frame
+                trackedJoints[i].Timestamp = clockSync.ToHost(
+                    pose.TimeInSeconds > 0.0 ? pose.TimeInSeconds : pose_time);
+
+                // Held lost poses never move, settled tracked ones only past the epsilon
+                if (!invalidated && state == previous && state != DropoutFilter::State::Inferred &&
+                    (state == DropoutFilter::State::Lost ||
+                        (dropouts[i].IsSettled(pose_time) && !changes.Moved(i, pose))))
+                    continue;
+
+                CopyPose(trackedJoints[i], pose);
+                trackedJoints[i].TrackingState = static_cast<JointTrackingState>(state); // Same order
+                trackedJoints[i].Confidence = dropouts[i].Confidence();
+
+                changes.Accept(i, pose);
+                dirty |= 1u << i;
             }
 
+            // Check how close the changed joints are to the play area edge
+            UpdateBoundaryProximity(dirty);
 
-            for (size_t i = 0; i < guardian->vrObjects; i++)
-            {
-                auto deviceType = static_cast<ovrTrackedDeviceType>(ovrTrackedDevice_Object0 + i);
-                ovrPoseStatef ovr_pose;
-
-                ovr_GetDevicePoses(guardian->mSession, &deviceType, 1,
-                                   (ovr_GetTimeInSeconds() + (static_cast<float>(extraPrediction) * 0.001)),
-                                   &ovr_pose);
-                if ((ovr_pose.ThePose.Orientation.x != 0) && (ovr_pose.ThePose.Orientation.y != 0) && (ovr_pose.ThePose.
-                    Orientation.z != 0))
+            // Move the changed joints into the calibrated space, gathered
+            // into one contiguous batch so the transform runs a single pass
+            std::array<JointSample, 3> batch;
+            std::array<size_t, 3> batched{};
+            size_t batch_size = 0;
+
+            const uint32_t moved = transform.IsIdentity() ? 0 : dirty; // Uncalibrated, skip the copies
+            for (size_t i = 0; i < trackedJoints.size(); i++)
+                if (moved & 1u << i)
                 {
-                    trackedJoints.at(2).Position = {
-                        ovr_pose.ThePose.Position.x,
-                        ovr_pose.ThePose.Position.y,
-                        ovr_pose.ThePose.Position.z
-                    };
-
-                    trackedJoints.at(2).Orientation = {
-                        ovr_pose.ThePose.Orientation.x,
-                        ovr_pose.ThePose.Orientation.y,
-                        ovr_pose.ThePose.Orientation.z,
-                        ovr_pose.ThePose.Orientation.w
-                    };
-
-                    trackedJoints.at(2).Velocity = {
-                        ovr_pose.LinearVelocity.x,
-                        ovr_pose.LinearVelocity.y,
-                        ovr_pose.LinearVelocity.z
-                    };
-
-                    trackedJoints.at(2).Acceleration = {
-                        ovr_pose.LinearAcceleration.x,
-                        ovr_pose.LinearAcceleration.y,
-                        ovr_pose.LinearAcceleration.z
-                    };
-
-                    trackedJoints.at(2).AngularVelocity = {
-                        ovr_pose.AngularVelocity.x,
-                        ovr_pose.AngularVelocity.y,
-                        ovr_pose.AngularVelocity.z
-                    };
-
-                    trackedJoints.at(2).AngularAcceleration = {
-                        ovr_pose.AngularAcceleration.x,
-                        ovr_pose.AngularAcceleration.y,
-                        ovr_pose.AngularAcceleration.z
-                    };
+                    batched[batch_size] = i;
+                    batch[batch_size++] = PoseSubscription::ToSample(trackedJoints[i]);
                 }
+
+            transform.Apply(batch.data(), batch_size);
+
+            for (size_t k = 0; k < batch_size; k++)
+            {
+                auto& joint = trackedJoints[batched[k]];
+                joint = PoseSubscription::FromSample(batch[k], joint.Name);
             }
 
+            changes.Publish(dirty, trackedJoints.size());
+
+            // One store for the bus, whoever is listening
+            std::array<JointSample, 3> samples;
+            for (size_t i = 0; i < samples.size(); i++)
+                samples[i] = PoseSubscription::ToSample(trackedJoints[i]);
+
+            bus->Publish(samples, dirty, clockSync.ToHost(pose_time));
+
             frame++; // Hit the frame counter
         }
     }
@@ -165,12 +203,24 @@ namespace winrt::DeviceHandler::implementation
 
         // Create a new guardian instance
         guardian = new(_aligned_malloc(sizeof(GuardianSystem), 16)) GuardianSystem(statusResult, Log);
+        guardian->pixelDensity = RenderDensity(config.Load());
+        requestedDensity.store(guardian->pixelDensity, std::memory_order_relaxed);
+        settingsVersion = (std::numeric_limits<uint64_t>::max)(); // Apply everything on the first frame
 
         // Assume success
         statusResult = S_OK;
 
         // Setup Oculus Stuff
         guardian->start_ovr();
+        PublishFootprint();
+
+        // Pose queries, frame submission and compositor stats run on their own threads from now on
+        if (statusResult == S_OK)
+        {
+            sampler.Start(guardian->mSession, guardian->vrObjects, watchdog, tracer);
+            submitter.Start([this] { SubmitFrame(); });
+            compositor.Start(guardian->mSession, watchdog);
+        }
 
         // Check the yield result
         if (statusResult == S_OK)
@@ -193,16 +243,24 @@ namespace winrt::DeviceHandler::implementation
 
         __try
         {
-            if (keepAlive)
+            oversampler.Stop(); // Before the session goes away
+            sampler.Stop();
+            submitter.Stop(); // Owns the eye targets until it's joined
+            compositor.Stop();
+
+            if (ODTKRAThread.joinable())
             {
-                ODTKRAstop = true;
+                RequestKeepAliveStop(false); // Leave ODT running, like before
                 ODTKRAThread.join();
             }
 
             guardian->DIRECTX.ReleaseDevice();
             ovr_Destroy(guardian->mSession);
             ovr_Shutdown();
-            delete[] guardian;
+
+            // Allocated with _aligned_malloc and placement new
+            guardian->~GuardianSystem();
+            _aligned_free(guardian);
 
             return 0;
         }
@@ -220,32 +278,166 @@ namespace winrt::DeviceHandler::implementation
 
     bool TrackingHandler::KeepAlive() const
     {
-        return keepAlive;
+        return config.Load().keepAlive;
     }
 
     void TrackingHandler::KeepAlive(bool value)
     {
-        keepAlive = value;
+        config.Modify([&](auto& c) { c.keepAlive = value; });
     }
 
     bool TrackingHandler::ReduceRes() const
     {
-        return resEnabled;
+        return config.Load().resEnabled;
     }
 
     void TrackingHandler::ReduceRes(bool value)
     {
-        resEnabled = value;
+        config.Modify([&](auto& c) { c.resEnabled = value; });
+    }
+
+    float TrackingHandler::PixelDensity() const
+    {
+        return config.Load().pixelDensity;
+    }
+
+    void TrackingHandler::PixelDensity(float value)
+    {
+        config.Modify([&](auto& c) { c.pixelDensity = std::clamp(value, 0.01f, 2.0f); });
+    }
+
+    bool TrackingHandler::Oversampling() const
+    {
+        return config.Load().oversampling;
+    }
+
+    void TrackingHandler::Oversampling(bool value)
+    {
+        config.Modify([&](auto& c) { c.oversampling = value; });
+    }
+
+    int32_t TrackingHandler::OversamplingRate() const
+    {
+        return config.Load().oversamplingRate;
+    }
+
+    void TrackingHandler::OversamplingRate(int32_t value)
+    {
+        config.Modify([&](auto& c) { c.oversamplingRate = std::clamp(value, 100, 2000); });
+    }
+
+    DecimationMode TrackingHandler::Decimation() const
+    {
+        return config.Load().decimation == PoseOversampler::Mode::Average
+                   ? DecimationMode::Average
+                   : DecimationMode::LinearFit;
+    }
+
+    void TrackingHandler::Decimation(DecimationMode value)
+    {
+        config.Modify([&](auto& c)
+        {
+            c.decimation = value == DecimationMode::Average
+                               ? PoseOversampler::Mode::Average
+                               : PoseOversampler::Mode::LinearFit;
+        });
+    }
+
+    float TrackingHandler::PositionEpsilon() const
+    {
+        return config.Load().positionEpsilon;
+    }
+
+    void TrackingHandler::PositionEpsilon(float value)
+    {
+        config.Modify([&](auto& c) { c.positionEpsilon = (std::max)(value, 0.f); });
+    }
+
+    float TrackingHandler::OrientationEpsilon() const
+    {
+        return config.Load().orientationEpsilon;
+    }
+
+    void TrackingHandler::OrientationEpsilon(float value)
+    {
+        config.Modify([&](auto& c) { c.orientationEpsilon = (std::max)(value, 0.f); });
+    }
+
+    ThreadSchedule TrackingHandler::SamplerSchedule() const
+    {
+        return ToSchedule(config.Load().samplerSchedule);
+    }
+
+    void TrackingHandler::SamplerSchedule(const ThreadSchedule& value)
+    {
+        if (!IsValid(value))
+        {
+            Log(std::format(L"Ignoring sampler schedule with unknown priority {}!", static_cast<int32_t>(value.Priority)), 1);
+            return;
+        }
+
+        config.Modify([&](auto& c) { c.samplerSchedule = ToPolicy(value); });
+    }
+
+    ThreadSchedule TrackingHandler::WorkerSchedule() const
+    {
+        return ToSchedule(config.Load().workerSchedule);
+    }
+
+    void TrackingHandler::WorkerSchedule(const ThreadSchedule& value)
+    {
+        if (!IsValid(value))
+        {
+            Log(std::format(L"Ignoring worker schedule with unknown priority {}!", static_cast<int32_t>(value.Priority)), 1);
+            return;
+        }
+
+        config.Modify([&](auto& c) { c.workerSchedule = ToPolicy(value); });
     }
 
     int32_t TrackingHandler::PredictionMs() const
     {
-        return extraPrediction;
+        return config.Load().extraPrediction;
     }
 
     void TrackingHandler::PredictionMs(int32_t value)
     {
-        extraPrediction = value;
+        config.Modify([&](auto& c) { c.extraPrediction = value; });
+    }
+
+    bool TrackingHandler::IdleThrottle() const
+    {
+        return config.Load().idleThrottle;
+    }
+
+    void TrackingHandler::IdleThrottle(bool value)
+    {
+        config.Modify([&](auto& c) { c.idleThrottle = value; });
+    }
+
+    SpaceCalibration TrackingHandler::Calibration() const
+    {
+        const auto transform = calibration.Load();
+        return {
+            .Rotation = {transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w},
+            .Translation = {transform.translation.x, transform.translation.y, transform.translation.z},
+            .Scale = transform.scale
+        };
+    }
+
+    void TrackingHandler::Calibration(const SpaceCalibration& value)
+    {
+        CalibrationTransform transform{
+            .translation = {value.Translation.X, value.Translation.Y, value.Translation.Z},
+            .scale = value.Scale > 0.f ? value.Scale : 1.f
+        };
+
+        // Keep the rotation normalized, fall back to identity if it's all zeros
+        const XMVECTOR rotation = XMVectorSet(value.Rotation.X, value.Rotation.Y, value.Rotation.Z, value.Rotation.W);
+        if (!XMVector4Equal(rotation, XMVectorZero()))
+            XMStoreFloat4(&transform.rotation, XMQuaternionNormalize(rotation));
+
+        calibration.Store(transform); // Picked up at the next frame
     }
 
     bool TrackingHandler::IsInitialized() const
@@ -258,6 +450,201 @@ namespace winrt::DeviceHandler::implementation
         return statusResult;
     }
 
+    PowerStats TrackingHandler::PowerStatus() const
+    {
+        const auto stats = governor.CurrentStats();
+        return {
+            .State = stats.state == IdleGovernor::State::Idle ? PowerState::Idle : PowerState::Active,
+            .ActiveSeconds = stats.activeSeconds,
+            .IdleSeconds = stats.idleSeconds,
+            .Transitions = stats.transitions
+        };
+    }
+
+    WatchdogStats TrackingHandler::Watchdog() const
+    {
+        using Call = StallWatchdog::Call;
+        const auto now = std::chrono::steady_clock::now();
+        const auto stats = watchdog.CurrentStats();
+
+        return {
+            .SubmitStalls = stats.stalls[static_cast<size_t>(Call::SubmitFrame)],
+            .TrackingStalls = stats.stalls[static_cast<size_t>(Call::TrackingState)],
+            .DevicePoseStalls = stats.stalls[static_cast<size_t>(Call::DevicePoses)],
+            .BoundaryStalls = stats.stalls[static_cast<size_t>(Call::BoundaryGeometry)],
+            .PerfStatsStalls = stats.stalls[static_cast<size_t>(Call::PerfStats)],
+            .WorstSubmitMs = stats.worstMs[static_cast<size_t>(Call::SubmitFrame)],
+            .WorstTrackingMs = stats.worstMs[static_cast<size_t>(Call::TrackingState)],
+            .WorstDevicePoseMs = stats.worstMs[static_cast<size_t>(Call::DevicePoses)],
+            .WorstBoundaryMs = stats.worstMs[static_cast<size_t>(Call::BoundaryGeometry)],
+            .WorstPerfStatsMs = stats.worstMs[static_cast<size_t>(Call::PerfStats)],
+            .StalenessMs = StallWatchdog::StalenessMs(stats, now),
+            .StaleFrames = stats.staleFrames,
+            .SkippedSubmits = submitter.Skipped(),
+            .BackingOff = watchdog.IsBackingOff(now)
+        };
+    }
+
+    RenderFootprint TrackingHandler::RenderTargets() const
+    {
+        return footprint.Load();
+    }
+
+    OversamplingStats TrackingHandler::OversamplingStatus() const
+    {
+        const auto stats = oversampler.CurrentStats();
+        return {
+            .Running = oversampler.IsRunning(),
+            .RateHz = stats.rateHz,
+            .CpuPercent = stats.cpuPercent,
+            .IntervalJitterMs = stats.intervalJitterMs,
+            .MaxIntervalMs = stats.maxIntervalMs,
+            .SamplesPerUpdate = stats.samplesPerUpdate,
+            .ResidualMm = stats.residualMm
+        };
+    }
+
+    ChangeStats TrackingHandler::Changes() const
+    {
+        const auto stats = changes.CurrentStats();
+        return {
+            .Updates = stats.updates,
+            .JointsProcessed = stats.jointsProcessed,
+            .JointsSkipped = stats.jointsSkipped,
+            .ConsumerPolls = stats.consumerPolls,
+            .CopiesSkipped = stats.copiesSkipped,
+            .ConsumerJointsSkipped = stats.consumerJointsSkipped,
+            .LastMask = changes.LastMask()
+        };
+    }
+
+    com_array<ThreadTiming> TrackingHandler::ThreadTimings() const
+    {
+        std::array<ThreadLauncher::WakeStats, ThreadLauncher::MaxThreads> stats{};
+        const auto count = ThreadLauncher::Stats(stats.data(), stats.size());
+
+        std::vector<ThreadTiming> timings;
+        timings.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+            timings.push_back({
+                .Name = to_hstring(std::string_view(stats[i].name)),
+                .Running = stats[i].running,
+                .ScheduleApplied = stats[i].applied,
+                .Wakeups = stats[i].wakeups,
+                .MeanLatencyUs = stats[i].meanUs,
+                .JitterUs = stats[i].jitterUs,
+                .MaxLatencyUs = stats[i].maxUs
+            });
+
+        return com_array<ThreadTiming>{timings};
+    }
+
+    com_array<JointNoiseStats> TrackingHandler::NoiseStats() const
+    {
+        std::vector<JointNoiseStats> result;
+        result.reserve(noise.size());
+
+        for (const auto& monitor : noise)
+        {
+            const auto stats = monitor.CurrentStats();
+            result.push_back({
+                .Samples = stats.samples,
+                .RestShare = stats.restShare,
+                .PositionJitterMm = stats.positionJitterMm,
+                .AngularJitterDeg = stats.angularJitterDeg,
+                .DeltaMeanMm = stats.deltaMeanMm,
+                .DeltaStdMm = stats.deltaStdMm,
+                .AngleDeltaMeanDeg = stats.angleDeltaMeanDeg,
+                .AngleDeltaStdDeg = stats.angleDeltaStdDeg,
+                .VelocityNoiseMms = stats.velocityNoiseMms,
+                .IntervalMeanMs = stats.intervalMeanMs,
+                .IntervalStdMs = stats.intervalStdMs,
+                .IntervalP50Ms = stats.intervalP50Ms,
+                .IntervalP99Ms = stats.intervalP99Ms,
+                .IntervalMaxMs = stats.intervalMaxMs,
+                .IntervalOverflows = stats.intervalOverflows
+            });
+        }
+
+        return com_array<JointNoiseStats>{result};
+    }
+
+    void TrackingHandler::ResetNoiseStats()
+    {
+        noiseResetRequested.store(true, std::memory_order_release); // Picked up at the next frame
+    }
+
+    ClockSyncStats TrackingHandler::ClockStatus() const
+    {
+        const auto stats = clockSync.CurrentStats();
+        return {
+            .OffsetSeconds = stats.offset,
+            .DriftPpm = stats.driftPpm,
+            .ResidualUs = stats.residualUs,
+            .BracketUs = stats.bracketUs,
+            .Pairs = stats.pairs,
+            .Rejected = stats.rejected
+        };
+    }
+
+    DeviceHandler::PoseSubscription TrackingHandler::Subscribe(const double rateHz, const uint32_t jointMask)
+    {
+        std::vector<hstring> names;
+        for (const auto& joint : trackedJoints) names.push_back(joint.Name);
+
+        return make<PoseSubscription>(bus, std::move(names), rateHz, jointMask);
+    }
+
+    uint32_t TrackingHandler::Subscribers() const
+    {
+        return bus->Readers();
+    }
+
+    com_array<CompositorStats> TrackingHandler::CompositorHistory() const
+    {
+        std::vector<CompositorStats> result;
+        for (const auto& window : compositor.History())
+            result.push_back({
+                .WindowSeconds = window.seconds,
+                .FrameCount = window.frames,
+                .CompositorDroppedFrames = window.compositorDropped,
+                .AppDroppedFrames = window.appDropped,
+                .AppLatencyMs = window.frames ? window.latencySum / window.frames * 1000.0 : 0.0,
+                .AppLatencyMaxMs = window.latencyMax * 1000.0,
+                .QueueAheadMs = window.frames ? window.queueAheadSum / window.frames * 1000.0 : 0.0,
+                .AswActive = window.aswActive,
+                .AswToggles = window.aswToggles,
+                .StatsOverflow = window.overflow
+            });
+
+        return com_array<CompositorStats>{result};
+    }
+
+    bool TrackingHandler::StartTrace(const hstring& path)
+    {
+        if (!tracer.Start(std::filesystem::path(path.c_str())))
+        {
+            Log(std::format(L"Couldn't open the trace file at {}!", path.c_str()), 2);
+            return false;
+        }
+
+        Log(std::format(L"Tracing the native pipeline to {}", path.c_str()), 0);
+        return true;
+    }
+
+    void TrackingHandler::StopTrace()
+    {
+        tracer.Stop();
+        if (const auto dropped = tracer.DroppedEvents(); dropped > 0)
+            Log(std::format(L"Trace finished, {} events were dropped", dropped), 1);
+    }
+
+    bool TrackingHandler::IsTracing() const
+    {
+        return tracer.IsEnabled();
+    }
+
     event_token TrackingHandler::LogEvent(const Windows::Foundation::EventHandler<hstring>& handler)
     {
         return logEvent.add(handler);
@@ -270,6 +657,14 @@ namespace winrt::DeviceHandler::implementation
 
     com_array<Joint> TrackingHandler::TrackedJoints() const
     {
+        TraceScope trace(tracer, "TrackedJoints");
+        governor.MarkConsumerRead(std::chrono::steady_clock::now());
         return winrt::com_array<Joint>{trackedJoints};
     }
+
+    uint32_t TrackingHandler::ConsumeChangedJoints()
+    {
+        governor.MarkConsumerRead(std::chrono::steady_clock::now());
+        return changes.Consume();
+    }
 }
@@ -1,6 +1,22 @@
 #pragma once
 #include "TrackingHandler.g.h"
 #include "GuardianSystem.h"
+#include "IdleGovernor.h"
+#include "CompositorMonitor.h"
+#include "GuardianBoundary.h"
+#include "AtomicSnapshot.h"
+#include "CalibrationTransform.h"
+#include "StallWatchdog.h"
+#include "FrameSubmitter.h"
+#include "TrackingSampler.h"
+#include "TraceRecorder.h"
+#include "DropoutFilter.h"
+#include "PoseOversampler.h"
+#include "ChangeDetector.h"
+#include "ThreadLauncher.h"
+#include "NoiseMonitor.h"
+#include "ClockSync.h"
+#include "PoseSubscription.h"
 
 namespace winrt::DeviceHandler::implementation
 {
@@ -18,16 +34,64 @@ namespace winrt::DeviceHandler::implementation
         [[nodiscard]] bool ReduceRes() const;
         void ReduceRes(bool value);
 
+        [[nodiscard]] float PixelDensity() const;
+        void PixelDensity(float value);
+
+        [[nodiscard]] bool Oversampling() const;
+        void Oversampling(bool value);
+
+        [[nodiscard]] int32_t OversamplingRate() const;
+        void OversamplingRate(int32_t value);
+
+        [[nodiscard]] DecimationMode Decimation() const;
+        void Decimation(DecimationMode value);
+
+        [[nodiscard]] float PositionEpsilon() const;
+        void PositionEpsilon(float value);
+
+        [[nodiscard]] float OrientationEpsilon() const;
+        void OrientationEpsilon(float value);
+
+        [[nodiscard]] ThreadSchedule SamplerSchedule() const;
+        void SamplerSchedule(const ThreadSchedule& value);
+
+        [[nodiscard]] ThreadSchedule WorkerSchedule() const;
+        void WorkerSchedule(const ThreadSchedule& value);
+
         [[nodiscard]] int32_t PredictionMs() const;
         void PredictionMs(int32_t value);
 
+        [[nodiscard]] bool IdleThrottle() const;
+        void IdleThrottle(bool value);
+
+        [[nodiscard]] SpaceCalibration Calibration() const;
+        void Calibration(const SpaceCalibration& value);
+
         [[nodiscard]] bool IsInitialized() const;
         [[nodiscard]] int32_t StatusResult() const;
+        [[nodiscard]] PowerStats PowerStatus() const;
+        [[nodiscard]] RenderFootprint RenderTargets() const;
+        [[nodiscard]] OversamplingStats OversamplingStatus() const;
+        [[nodiscard]] ChangeStats Changes() const;
+        [[nodiscard]] com_array<ThreadTiming> ThreadTimings() const;
+        [[nodiscard]] com_array<JointNoiseStats> NoiseStats() const;
+        void ResetNoiseStats();
+        [[nodiscard]] ClockSyncStats ClockStatus() const;
+
+        DeviceHandler::PoseSubscription Subscribe(double rateHz, uint32_t jointMask);
+        [[nodiscard]] uint32_t Subscribers() const;
+        [[nodiscard]] WatchdogStats Watchdog() const;
+        [[nodiscard]] com_array<CompositorStats> CompositorHistory() const;
 
         event_token LogEvent(const Windows::Foundation::EventHandler<hstring>& handler);
         void LogEvent(const event_token& token) noexcept;
 
         [[nodiscard]] com_array<Joint> TrackedJoints() const;
+        uint32_t ConsumeChangedJoints();
+
+        bool StartTrace(const hstring& path);
+        void StopTrace();
+        [[nodiscard]] bool IsTracing() const;
 
     private:
         event<Windows::Foundation::EventHandler<hstring>> logEvent;
@@ -44,12 +108,44 @@ namespace winrt::DeviceHandler::implementation
             Joint{.Name = L"Oculus VR Headset"}
         };
 
+        // Latest raw poses in the OVR origin, in joint order
+        std::array<ovrPoseStatef, 3> rawPoses{};
+        std::array<bool, 3> rawTracked{};
+        std::array<DropoutFilter, 3> dropouts{};
+
+        TrackingSampler sampler;
+        uint64_t lastSampleSequence = 0;
+
+        PoseOversampler oversampler;
+        double lastSampleTime = 0.0;
+
+        ChangeDetector changes;
+        uint64_t appliedCalibration = 0;
+
+        std::array<NoiseMonitor, 3> noise;
+        std::atomic<bool> noiseResetRequested{false};
+
+        ClockSync clockSync;
+
+        // Readers hold on to it too, so it can outlive us
+        std::shared_ptr<JointBus> bus = std::make_shared<JointBus>();
+
         std::thread ODTKRAThread;
+        std::mutex ODTKRAMutex;
+        std::condition_variable ODTKRAWake;
         GuardianSystem* guardian;
+        IdleGovernor governor;
+        CompositorMonitor compositor;
+        FrameSubmitter submitter;
+        GuardianBoundary boundary;
+        AtomicSnapshot<CalibrationTransform> calibration;
+        StallWatchdog watchdog;
+        mutable TraceRecorder tracer;
 
         unsigned int frame = 0;
-        bool is_ODTKRA_started = false;
-        bool ODTKRAstop = false;
+        std::atomic<bool> ODTKRAstop{false}; // Written under <ODTKRAMutex>
+        std::atomic<bool> ODTKRAclose{false}; // Close ODT on the way out
+        std::atomic<bool> ODTKRAfinished{false}; // The worker has returned, joining won't block
 
         // Message logging handler: bound to <Log>
         void LogMessage(const std::wstring& message, const int32_t& severity)
@@ -61,17 +157,221 @@ namespace winrt::DeviceHandler::implementation
         // LLC\\Oculus", L"Base", RRF_RT_ANY, NULL, (PVOID)&value, &BufferSize);
         std::wstring ODTPath = L"Test";
 
-        int extraPrediction = 11;
-        bool keepAlive = false;
-        bool resEnabled = true;
+        // Immutable settings block, swapped in whole by the setters
+        struct HandlerConfig
+        {
+            int32_t extraPrediction = 11;
+            bool keepAlive = false;
+            bool resEnabled = true;
+            bool idleThrottle = true;
+            float pixelDensity = 0.01f; // Eye target density while resEnabled
+            bool oversampling = false;
+            int32_t oversamplingRate = 1000; // [Hz]
+            PoseOversampler::Mode decimation = PoseOversampler::Mode::LinearFit;
+            float positionEpsilon = 0.0002f; // [m] Smaller moves don't count as a change
+            float orientationEpsilon = 0.0005f; // [rad] Smaller turns don't count as a change
+            ThreadLauncher::Policy samplerSchedule{.priority = ThreadLauncher::Priority::High};
+            ThreadLauncher::Policy workerSchedule{};
+        };
 
-        void killODT() const
+        // The projected enum can carry any value, only the ones we know map onto a priority
+        static bool IsValid(const ThreadSchedule& schedule)
+        {
+            return schedule.Priority >= ThreadPriority::Low && schedule.Priority <= ThreadPriority::Critical;
+        }
+
+        static ThreadLauncher::Policy ToPolicy(const ThreadSchedule& schedule)
+        {
+            return {
+                .priority = static_cast<ThreadLauncher::Priority>(schedule.Priority), // Same order
+                .affinity = schedule.AffinityMask,
+                .realtime = schedule.Realtime
+            };
+        }
+
+        static ThreadSchedule ToSchedule(const ThreadLauncher::Policy& policy)
+        {
+            return {
+                .Priority = static_cast<ThreadPriority>(policy.priority),
+                .AffinityMask = policy.affinity,
+                .Realtime = policy.realtime
+            };
+        }
+
+        // Eye target density actually requested from the runtime
+        static float RenderDensity(const HandlerConfig& value)
+        {
+            return value.resEnabled ? value.pixelDensity : 1.0f;
+        }
+
+        AtomicSnapshot<RenderFootprint> footprint;
+
+        // Publish the current eye target sizes, frame submitter thread only once it's running
+        void PublishFootprint()
+        {
+            const auto size = guardian->RenderTargetSize();
+            footprint.Store({
+                .EyeWidth = size.w, .EyeHeight = size.h,
+                .PixelDensity = guardian->pixelDensity,
+                .Bytes = guardian->RenderTargetBytes()
+            });
+        }
+
+        AtomicSnapshot<HandlerConfig> config;
+        HandlerConfig settings{}; // Applied at the last frame boundary
+        uint64_t settingsVersion = 0;
+
+        // Pick up new settings at a frame boundary, never blocks
+        void ApplyConfig()
+        {
+            uint64_t version = 0;
+            const auto value = config.Load(&version);
+            if (version == settingsVersion) return;
+
+            // Resize our eye targets in-process, live, before the next submission
+            requestedDensity.store(RenderDensity(value), std::memory_order_relaxed);
+
+            // Running threads pick these up on their next wake
+            ThreadLauncher::Configure(ThreadLauncher::Role::Sampler, value.samplerSchedule);
+            ThreadLauncher::Configure(ThreadLauncher::Role::Worker, value.workerSchedule);
+
+            // Start, restart or stop the high-rate sampler
+            if (value.oversampling && (!oversampler.IsRunning() || value.oversamplingRate != settings.oversamplingRate))
+            {
+                oversampler.Start(guardian->mSession, guardian->vrObjects, value.oversamplingRate);
+                Log(std::format(L"Oversampling poses at {} Hz", value.oversamplingRate), 0);
+            }
+            else if (!value.oversampling && oversampler.IsRunning())
+                oversampler.Stop();
+
+            changes.SetEpsilon(value.positionEpsilon, value.orientationEpsilon);
+            changes.Invalidate(); // Re-export everything under the new thresholds
+
+            settings = value;
+            settingsVersion = version;
+        }
+
+        std::atomic<float> requestedDensity{1.0f}; // Eye target density for the submitter
+
+        // Submit a frame, with any new density applied first, frame submitter thread only
+        void SubmitFrame()
         {
-            // Reverse ODT cli commands
-            std::wstring temp = std::format(
-                L"echo service set-pixels-per-display-pixel-override 1 | \"{}OculusDebugToolCLI.exe\"", ODTPath);
-            ShellExecute(NULL, L"cmd.exe", temp.c_str(), NULL, NULL, SW_HIDE);
+            if (tracer.IsEnabled()) tracer.NameThread("Frame submitter");
 
+            if (const auto density = requestedDensity.load(std::memory_order_relaxed);
+                density != guardian->pixelDensity)
+            {
+                guardian->SetPixelDensity(density);
+                PublishFootprint();
+
+                Log(std::format(L"Eye targets rebuilt at {} pixel density, {} KiB in total",
+                                density, guardian->RenderTargetBytes() / 1024), 0);
+            }
+
+            if (!watchdog.Time(StallWatchdog::Call::SubmitFrame, [this]
+            {
+                TraceScope trace(tracer, "SubmitFrame");
+                guardian->Render();
+            }))
+                Log(L"ovr_SubmitFrame overran its deadline, backing off submissions", 1);
+        }
+
+        // Copy a raw OVR pose into an exported joint
+        static void CopyPose(Joint& joint, const ovrPoseStatef& pose)
+        {
+            joint.Position = {pose.ThePose.Position.x, pose.ThePose.Position.y, pose.ThePose.Position.z};
+            joint.Orientation = {
+                pose.ThePose.Orientation.x, pose.ThePose.Orientation.y,
+                pose.ThePose.Orientation.z, pose.ThePose.Orientation.w
+            };
+
+            joint.Velocity = {pose.LinearVelocity.x, pose.LinearVelocity.y, pose.LinearVelocity.z};
+            joint.Acceleration = {pose.LinearAcceleration.x, pose.LinearAcceleration.y, pose.LinearAcceleration.z};
+            joint.AngularVelocity = {pose.AngularVelocity.x, pose.AngularVelocity.y, pose.AngularVelocity.z};
+            joint.AngularAcceleration = {
+                pose.AngularAcceleration.x, pose.AngularAcceleration.y, pose.AngularAcceleration.z
+            };
+        }
+
+        // Run the boundary kernel over the joints in <mask>, write results back
+        void UpdateBoundaryProximity(const uint32_t mask)
+        {
+            constexpr size_t max_joints = 8;
+            std::array<float, max_joints> px{}, pz{}, distance{}, cx{}, cz{};
+            std::array<size_t, max_joints> index{};
+            size_t count = 0;
+
+            for (size_t i = 0; i < (std::min)(trackedJoints.size(), max_joints); i++)
+            {
+                if (!(mask & 1u << i)) continue;
+                index[count] = i;
+                px[count] = trackedJoints[i].Position.X;
+                pz[count] = trackedJoints[i].Position.Z;
+                count++;
+            }
+
+            if (count == 0) return;
+            boundary.Query(px.data(), pz.data(), count, distance.data(), cx.data(), cz.data());
+
+            for (size_t i = 0; i < count; i++)
+            {
+                trackedJoints[index[i]].BoundaryDistance = distance[i];
+                trackedJoints[index[i]].BoundaryPoint = {cx[i], boundary.FloorHeight(), cz[i]};
+            }
+        }
+
+        // Gather every tracked device the governor should watch for movement
+        static IdleGovernor::Probe ProbeMotion(const TrackingSampler::Sample& sample)
+        {
+            static_assert(TrackingSampler::JointCount + 1 <= IdleGovernor::MaxProbes);
+
+            IdleGovernor::Probe probe{};
+            probe.poses[0] = sample.head.ThePose;
+            probe.tracked[0] = sample.headTracked;
+
+            for (size_t i = 0; i < sample.poses.size(); i++)
+            {
+                probe.poses[i + 1] = sample.poses[i].ThePose; // Both hands, then the object
+                probe.tracked[i + 1] = sample.tracked[i];
+            }
+
+            return probe;
+        }
+
+        // Start or stop the keep-alive worker to match the settings, Update thread only
+        // Closing ODT and winding down happen on the worker, we only reap it once it's done
+        void SteerKeepAlive()
+        {
+            if (ODTKRAThread.joinable() && ODTKRAfinished.load(std::memory_order_acquire))
+                ODTKRAThread.join(); // Already returned
+
+            if (settings.keepAlive && !ODTKRAThread.joinable())
+            {
+                ODTKRAstop = false;
+                ODTKRAfinished.store(false, std::memory_order_release);
+                ODTKRAThread = ThreadLauncher::Launch("ODT keep-alive", ThreadLauncher::Role::Worker, [this]
+                {
+                    keepRiftAlive();
+                    ODTKRAfinished.store(true, std::memory_order_release);
+                });
+            }
+            else if (!settings.keepAlive && ODTKRAThread.joinable() && !ODTKRAstop)
+                RequestKeepAliveStop(true);
+        }
+
+        void RequestKeepAliveStop(const bool closeTool)
+        {
+            {
+                std::lock_guard lock(ODTKRAMutex);
+                ODTKRAclose = closeTool;
+                ODTKRAstop = true;
+            }
+
+            ODTKRAWake.notify_all();
+        }
+
+        void killODT() const
+        {
             if (HWND hWindowHandle =
                     FindWindow(NULL, L"Oculus Debug Tool");
                 hWindowHandle != NULL)
@@ -117,18 +417,6 @@ namespace winrt::DeviceHandler::implementation
             ShowWindow(hWindowHandle, SW_MINIMIZE);
         }
 
-        void ODT_CLI()
-        {
-            //Sets "set-pixels-per-display-pixel-override" to 0.01 to decrease performance overhead
-            std::wstring temp = std::format(
-                L"echo service set-pixels-per-display-pixel-override 0.01 | \"{}OculusDebugToolCLI.exe\"", ODTPath);
-            ShellExecute(NULL, L"cmd.exe", temp.c_str(), NULL, NULL, SW_HIDE);
-
-            //Turn off ASW, we do not need it
-            temp = std::format(L"echo server: asw.Off | \"{}OculusDebugToolCLI.exe\"", ODTPath);
-            ShellExecute(NULL, L"cmd.exe", temp.c_str(), NULL, NULL, SW_HIDE);
-        }
-
         void keepRiftAlive()
         {
             int seconds = 600000;
@@ -144,11 +432,6 @@ namespace winrt::DeviceHandler::implementation
 
             Sleep(500); // not sure if needed
 
-            //Sends commands to the Oculus Debug Tool CLI to decrease performance overhead
-            //Unlikely to do much, but no reason not to.
-            if (resEnabled)
-                ODT_CLI();
-
             //Starts Oculus Debug Tool
             //std::string temp = ODTPath + "OculusDebugTool.exe";
             //TestOutput->Text(std::wstring(temp.begin(), temp.end()));
@@ -158,21 +441,21 @@ namespace winrt::DeviceHandler::implementation
             Sleep(1000);
 
             if (check_ODT() == false)
-            {
-                is_ODTKRA_started = false;
-                return;
-            }
+                return; // Reaped and retried on a later frame
 
 
             hWindowHandle = FindWindow(nullptr, Target_window_Name);
 
             HWND PropertGrid = FindWindowEx(hWindowHandle, nullptr, L"wxWindowNR", nullptr);
             HWND wxWindow = FindWindowEx(PropertGrid, nullptr, L"wxWindow", nullptr);
+            if (tracer.IsEnabled()) tracer.NameThread("ODT keep-alive");
+            auto next = std::chrono::steady_clock::now();
 
             while (!ODTKRAstop)
             {
                 if (seconds == 600000)
                 {
+                    TraceScope trace(tracer, "KeepAliveNudge");
                     SendMessage(wxWindow, WM_KEYDOWN, VK_UP, 0);
                     SendMessage(wxWindow, WM_KEYUP, VK_UP, 0);
                     Sleep(50);
@@ -182,10 +465,19 @@ namespace winrt::DeviceHandler::implementation
                 }
 
                 seconds++;
-                Sleep(1000);
+                next += std::chrono::seconds(1);
+
+                // Sleep until the next tick, unless we're told to stop first
+                {
+                    std::unique_lock lock(ODTKRAMutex);
+                    if (ODTKRAWake.wait_until(lock, next, [this] { return ODTKRAstop.load(); })) break;
+                }
+
+                ThreadLauncher::MarkWake(next);
+                tracer.Record("KeepAliveWake", 'i');
             }
 
-            ODTKRAstop = false;
+            if (ODTKRAclose) killODT();
         }
     };
 }
@@ -0,0 +1,212 @@
+#pragma once
+#include <pch.h>
+
+#include <condition_variable>
+
+#include "AtomicSnapshot.h"
+#include "PoseOversampler.h"
+#include "StallWatchdog.h"
+#include "ThreadLauncher.h"
+#include "TraceRecorder.h"
+#include <OVR_CAPI.h>
+
+// Runs the blocking OVR pose queries on a thread of their own, so a stalling
+// runtime never holds Update() up: the host asks for a sample, waits for it
+// up to a deadline, and otherwise carries on with the newest one published
+class TrackingSampler
+{
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr size_t JointCount = PoseOversampler::JointCount; // Same joint order
+
+    struct Sample
+    {
+        uint64_t sequence = 0; // 0 until the first sample is in
+        double time = 0.0; // OVR seconds the poses were predicted for
+        clock::time_point completed{}; // When the queries returned
+        bool hmdMounted = false;
+        bool headTracked = false;
+        ovrPoseStatef head{};
+        std::array<ovrPoseStatef, JointCount> poses{};
+        std::array<bool, JointCount> tracked{};
+    };
+
+    TrackingSampler() = default;
+    TrackingSampler(const TrackingSampler&) = delete;
+    TrackingSampler& operator=(const TrackingSampler&) = delete;
+
+    ~TrackingSampler()
+    {
+        Stop();
+    }
+
+    // Start serving requests against <session>, restarts if already running
+    void Start(const ovrSession session, const uint32_t objects, StallWatchdog& stallWatchdog, TraceRecorder& recorder)
+    {
+        Stop();
+
+        sampledSession = session;
+        objectCount = objects;
+        watchdog = &stallWatchdog;
+        tracer = &recorder;
+
+        {
+            std::lock_guard lock(mutex);
+            stopRequested = false;
+            pending = false;
+        }
+
+        latest.Store({});
+        worker = ThreadLauncher::Launch("Tracking sampler", ThreadLauncher::Role::Sampler, [this] { Run(); });
+    }
+
+    // Waits for a call in flight to return, the session must outlive it
+    void Stop()
+    {
+        if (!worker.joinable()) return;
+
+        {
+            std::lock_guard lock(mutex);
+            stopRequested = true;
+        }
+
+        wake.notify_all();
+        done.notify_all();
+        worker.join();
+    }
+
+    // Ask for the poses at <time>, returns the sequence the sample will get
+    // Returns 0 while the last request is still running or the runtime is being backed off
+    uint64_t Request(const double time)
+    {
+        const auto now = clock::now();
+        if (!watchdog || !watchdog->ShouldRun(StallWatchdog::Call::TrackingState, now) ||
+            !watchdog->ShouldRun(StallWatchdog::Call::DevicePoses, now))
+            return 0;
+
+        uint64_t sequence;
+        {
+            std::lock_guard lock(mutex);
+            if (pending || stopRequested) return 0;
+
+            pending = true;
+            requestedTime = time;
+            requestedAt = now;
+            sequence = ++requested;
+        }
+
+        wake.notify_one();
+        return sequence;
+    }
+
+    // Wait for sample <sequence> until <deadline>, returns false if it's late
+    // A late sample isn't lost, it's published whenever it does come in
+    bool WaitFor(const uint64_t sequence, const clock::time_point deadline)
+    {
+        std::unique_lock lock(mutex);
+        return done.wait_until(lock, deadline, [&] { return completed >= sequence || stopRequested; }) &&
+            completed >= sequence;
+    }
+
+    // Newest published sample, safe from any thread
+    [[nodiscard]] Sample Latest() const
+    {
+        return latest.Load();
+    }
+
+private:
+    void Run()
+    {
+        if (tracer->IsEnabled()) tracer->NameThread("Tracking sampler");
+
+        while (true)
+        {
+            Sample sample;
+            clock::time_point due;
+
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [this] { return stopRequested || pending; });
+                if (stopRequested) return;
+
+                sample.sequence = requested;
+                sample.time = requestedTime;
+                due = requestedAt;
+            }
+
+            ThreadLauncher::MarkWake(due); // How long the request took to get picked up
+            Query(sample);
+            sample.completed = clock::now();
+            latest.Store(sample);
+
+            {
+                std::lock_guard lock(mutex);
+                completed = sample.sequence;
+                pending = false;
+            }
+
+            done.notify_all();
+        }
+    }
+
+    // Everything we export, for one predicted time
+    void Query(Sample& sample) const
+    {
+        watchdog->Time(StallWatchdog::Call::TrackingState, [&, this]
+        {
+            TraceScope trace(*tracer, "GetTrackingState");
+
+            ovrSessionStatus status{};
+            ovr_GetSessionStatus(sampledSession, &status);
+            sample.hmdMounted = status.HmdMounted == ovrTrue;
+
+            const auto state = ovr_GetTrackingState(sampledSession, sample.time, ovrTrue);
+            sample.head = state.HeadPose;
+            sample.headTracked = (state.StatusFlags & ovrStatus_OrientationTracked) != 0;
+
+            for (int i = 0; i <= 1; i++)
+            {
+                constexpr unsigned int tracked_flags = ovrStatus_OrientationTracked | ovrStatus_PositionTracked;
+                sample.poses[i] = state.HandPoses[i];
+                sample.tracked[i] = (state.HandStatusFlags[i] & tracked_flags) == tracked_flags;
+            }
+        });
+
+        for (uint32_t i = 0; i < objectCount; i++)
+        {
+            auto deviceType = static_cast<ovrTrackedDeviceType>(ovrTrackedDevice_Object0 + i);
+            ovrPoseStatef pose{};
+            bool valid = false;
+
+            watchdog->Time(StallWatchdog::Call::DevicePoses, [&, this]
+            {
+                TraceScope trace(*tracer, "GetDevicePoses");
+                valid = OVR_SUCCESS(ovr_GetDevicePoses(sampledSession, &deviceType, 1, sample.time, &pose));
+            });
+
+            if (valid && PoseOversampler::HasPose(pose))
+            {
+                sample.poses[2] = pose;
+                sample.tracked[2] = true;
+            }
+        }
+    }
+
+    ovrSession sampledSession = nullptr;
+    uint32_t objectCount = 0;
+    StallWatchdog* watchdog = nullptr;
+    TraceRecorder* tracer = nullptr;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+
+    // Under <mutex>
+    bool stopRequested = false;
+    bool pending = false;
+    uint64_t requested = 0, completed = 0;
+    double requestedTime = 0.0;
+    clock::time_point requestedAt{};
+
+    AtomicSnapshot<Sample> latest;
+};
@@ -4,7 +4,6 @@
 using System;
 using System.Collections.ObjectModel;
 using System.ComponentModel.Composition;
-using System.Linq;
 using System.Numerics;
 using System.Threading;
 using System.Timers;
@@ -175,6 +174,7 @@ public class TouchLink : ITrackingDevice
             sender.Value = Math.Clamp(sender.Value, 0, 100);
 
             PredictionMs = (int)sender.Value; // Also save!
+            Handler.PredictionMs = PredictionMs; // Applied on the next frame
             Host.PluginSettings.SetSetting("PredictionMs", PredictionMs);
             Host.PlayAppSound(SoundType.Invoke);
         };
@@ -182,6 +182,7 @@ public class TouchLink : ITrackingDevice
         KeepAliveToggleSwitch.Toggled += (sender, _) =>
         {
             KeepRiftAlive = (sender as ToggleSwitch)?.IsOn ?? false;
+            Handler.KeepAlive = KeepRiftAlive; // Applied on the next frame
             Host.PluginSettings.SetSetting("KeepRiftAlive", KeepRiftAlive);
             Host.PlayAppSound(KeepRiftAlive ? SoundType.ToggleOn : SoundType.ToggleOff);
         };
@@ -189,6 +190,7 @@ public class TouchLink : ITrackingDevice
         ReduceResToggleSwitch.Toggled += (sender, _) =>
         {
             ReduceResolution = (sender as ToggleSwitch)?.IsOn ?? true;
+            Handler.ReduceRes = ReduceResolution; // Applied on the next frame
             Host.PluginSettings.SetSetting("ReduceResolution", ReduceResolution);
             Host.PlayAppSound(ReduceResolution ? SoundType.ToggleOn : SoundType.ToggleOff);
         };
@@ -288,28 +290,40 @@ public class TouchLink : ITrackingDevice
         {
             Handler.Update(); // Update the service
 
-            // Refresh all controllers/all
-            using var jointEnumerator = TrackedJoints.GetEnumerator();
-            Handler.TrackedJoints?.ToList()
-                .ForEach(vrObject =>
+            // Skip the copy altogether if nothing's moved since the last frame
+            var changed = Handler.ConsumeChangedJoints();
+            if (changed == 0) return;
+
+            // Refresh changed controllers/all (no intermediate list, this runs every frame)
+            var objects = Handler.TrackedJoints;
+            if (objects is null) return;
+
+            for (var i = 0; i < objects.Length && i < TrackedJoints.Count; i++)
+            {
+                if ((changed & (1u << i)) == 0) continue; // Still where we left it
+
+                var vrObject = objects[i];
+                var joint = TrackedJoints[i];
+                if (joint is null) continue;
+
+                // Copy pose data from the controller
+                joint.Position = vrObject.Position.ToNet();
+                joint.Orientation = vrObject.Orientation.ToNet();
+
+                // Copy physics data from the controller
+                joint.Velocity = vrObject.Velocity.ToNet();
+                joint.Acceleration = vrObject.Acceleration.ToNet();
+                joint.AngularVelocity = vrObject.AngularVelocity.ToNet();
+                joint.AngularAcceleration = vrObject.AngularAcceleration.ToNet();
+
+                // Parse/copy the tracking state
+                joint.TrackingState = vrObject.TrackingState switch
                 {
-                    // Ove to the next controller list entry
-                    if (!jointEnumerator.MoveNext() ||
-                        jointEnumerator.Current is null) return;
-
-                    // Copy pose data from the controller
-                    jointEnumerator.Current.Position = vrObject.Position.ToNet();
-                    jointEnumerator.Current.Orientation = vrObject.Orientation.ToNet();
-
-                    // Copy physics data from the controller
-                    jointEnumerator.Current.Velocity = vrObject.Velocity.ToNet();
-                    jointEnumerator.Current.Acceleration = vrObject.Acceleration.ToNet();
-                    jointEnumerator.Current.AngularVelocity = vrObject.AngularVelocity.ToNet();
-                    jointEnumerator.Current.AngularAcceleration = vrObject.AngularAcceleration.ToNet();
-
-                    // Parse/copy the tracking state
-                    jointEnumerator.Current.TrackingState = TrackedJointState.StateTracked;
-                });
+                    JointTrackingState.Tracked => TrackedJointState.StateTracked,
+                    JointTrackingState.Inferred => TrackedJointState.StateInferred,
+                    _ => TrackedJointState.StateNotTracked
+                };
+            }
         }
         catch (Exception e)
         {